@@ -26,6 +26,24 @@ namespace esphome {
 namespace api {
 
 static const char *const TAG = "api.connection";
+
+void DeferredStateQueue::defer(EntityBase *entity, send_state_t send_state) {
+  if (!this->pending_.insert(entity).second)
+    return;
+  this->items_.push_back({entity, send_state});
+}
+
+void DeferredStateQueue::process(APIConnection *conn) {
+  size_t sent = 0;
+  while (sent < this->items_.size()) {
+    const Item &item = this->items_[sent];
+    if (!item.send_state(conn, item.entity))
+      break;
+    this->pending_.erase(item.entity);
+    sent++;
+  }
+  this->items_.erase(this->items_.begin(), this->items_.begin() + sent);
+}
 static const int ESP32_CAMERA_STOP_STREAM = 5000;
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
@@ -68,6 +86,23 @@ APIConnection::~APIConnection() {
 #endif
 }
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+bool APIConnection::needs_polling() {
+  if (this->remove_ || this->next_close_)
+    return true;
+  if (!this->deferred_states_.empty() || !this->batch_buffer_.empty())
+    return true;
+  if (this->list_entities_iterator_.is_active() || this->initial_state_iterator_.is_active())
+    return true;
+#ifdef USE_ESP32_CAMERA
+  if (this->image_reader_.available())
+    return true;
+#endif
+  // Buffered output is only flushed from loop(), and sockets only wake the loop when they become readable
+  return !this->helper_->can_write_without_blocking();
+}
+#endif
+
 void APIConnection::loop() {
   if (this->remove_)
     return;
@@ -116,9 +151,14 @@ void APIConnection::loop() {
       return;
   }
 
+  this->deferred_states_.process(this);
   this->list_entities_iterator_.advance();
   this->initial_state_iterator_.advance();
 
+  if (!this->batch_buffer_.empty() && millis() - this->batch_started_ >= this->parent_->get_batch_delay()) {
+    this->flush_batch_();
+  }
+
   static uint32_t keepalive = 60000;
   static uint8_t max_ping_retries = 60;
   static uint16_t ping_retry_interval = 1000;
@@ -152,13 +192,19 @@ void APIConnection::loop() {
 #ifdef USE_ESP32_CAMERA
   if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
     uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
+    uint32_t key = esp32_camera::global_esp32_camera->get_object_id_hash();
+    bool done = this->image_reader_.available() == to_send;
+    uint32_t msg_size = 0;
+    ProtoSize::add_fixed32(msg_size, 1, key);
+    ProtoSize::add_bytes(msg_size, 2, to_send);
+    ProtoSize::add_bool(msg_size, 3, done);
+
+    auto buffer = this->create_buffer(msg_size);
     // fixed32 key = 1;
-    buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
+    buffer.encode_fixed32(1, key);
     // bytes data = 2;
     buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
     // bool done = 3;
-    bool done = this->image_reader_.available() == to_send;
     buffer.encode_bool(3, done);
     bool success = this->send_buffer(buffer, 44);
 
@@ -206,13 +252,13 @@ void APIConnection::on_disconnect_response(const DisconnectResponse &value) {
 }
 
 #ifdef USE_BINARY_SENSOR
-bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state) {
-  if (!this->state_subscription_)
-    return false;
-
+bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor) {
+  return this->send_state_<binary_sensor::BinarySensor, &APIConnection::try_send_binary_sensor_state>(binary_sensor);
+}
+bool APIConnection::try_send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor) {
   BinarySensorStateResponse resp;
   resp.key = binary_sensor->get_object_id_hash();
-  resp.state = state;
+  resp.state = binary_sensor->state;
   resp.missing_state = !binary_sensor->has_state();
   return this->send_binary_sensor_state_response(resp);
 }
@@ -234,9 +280,9 @@ bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_
 
 #ifdef USE_COVER
 bool APIConnection::send_cover_state(cover::Cover *cover) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<cover::Cover, &APIConnection::try_send_cover_state>(cover);
+}
+bool APIConnection::try_send_cover_state(cover::Cover *cover) {
   auto traits = cover->get_traits();
   CoverStateResponse resp{};
   resp.key = cover->get_object_id_hash();
@@ -297,9 +343,9 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
 
 #ifdef USE_FAN
 bool APIConnection::send_fan_state(fan::Fan *fan) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<fan::Fan, &APIConnection::try_send_fan_state>(fan);
+}
+bool APIConnection::try_send_fan_state(fan::Fan *fan) {
   auto traits = fan->get_traits();
   FanStateResponse resp{};
   resp.key = fan->get_object_id_hash();
@@ -358,9 +404,9 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
 
 #ifdef USE_LIGHT
 bool APIConnection::send_light_state(light::LightState *light) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<light::LightState, &APIConnection::try_send_light_state>(light);
+}
+bool APIConnection::try_send_light_state(light::LightState *light) {
   auto traits = light->get_traits();
   auto values = light->remote_values;
   auto color_mode = values.get_color_mode();
@@ -455,13 +501,13 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
 #endif
 
 #ifdef USE_SENSOR
-bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
-  if (!this->state_subscription_)
-    return false;
-
+bool APIConnection::send_sensor_state(sensor::Sensor *sensor) {
+  return this->send_state_<sensor::Sensor, &APIConnection::try_send_sensor_state>(sensor);
+}
+bool APIConnection::try_send_sensor_state(sensor::Sensor *sensor) {
   SensorStateResponse resp{};
   resp.key = sensor->get_object_id_hash();
-  resp.state = state;
+  resp.state = sensor->state;
   resp.missing_state = !sensor->has_state();
   return this->send_sensor_state_response(resp);
 }
@@ -487,13 +533,13 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
 #endif
 
 #ifdef USE_SWITCH
-bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
-  if (!this->state_subscription_)
-    return false;
-
+bool APIConnection::send_switch_state(switch_::Switch *a_switch) {
+  return this->send_state_<switch_::Switch, &APIConnection::try_send_switch_state>(a_switch);
+}
+bool APIConnection::try_send_switch_state(switch_::Switch *a_switch) {
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
-  resp.state = state;
+  resp.state = a_switch->state;
   return this->send_switch_state_response(resp);
 }
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
@@ -524,13 +570,13 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
 #endif
 
 #ifdef USE_TEXT_SENSOR
-bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state) {
-  if (!this->state_subscription_)
-    return false;
-
+bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor) {
+  return this->send_state_<text_sensor::TextSensor, &APIConnection::try_send_text_sensor_state>(text_sensor);
+}
+bool APIConnection::try_send_text_sensor_state(text_sensor::TextSensor *text_sensor) {
   TextSensorStateResponse resp{};
   resp.key = text_sensor->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = text_sensor->state;
   resp.missing_state = !text_sensor->has_state();
   return this->send_text_sensor_state_response(resp);
 }
@@ -552,9 +598,9 @@ bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor)
 
 #ifdef USE_CLIMATE
 bool APIConnection::send_climate_state(climate::Climate *climate) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<climate::Climate, &APIConnection::try_send_climate_state>(climate);
+}
+bool APIConnection::try_send_climate_state(climate::Climate *climate) {
   auto traits = climate->get_traits();
   ClimateStateResponse resp{};
   resp.key = climate->get_object_id_hash();
@@ -659,13 +705,13 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
 #endif
 
 #ifdef USE_NUMBER
-bool APIConnection::send_number_state(number::Number *number, float state) {
-  if (!this->state_subscription_)
-    return false;
-
+bool APIConnection::send_number_state(number::Number *number) {
+  return this->send_state_<number::Number, &APIConnection::try_send_number_state>(number);
+}
+bool APIConnection::try_send_number_state(number::Number *number) {
   NumberStateResponse resp{};
   resp.key = number->get_object_id_hash();
-  resp.state = state;
+  resp.state = number->state;
   resp.missing_state = !number->has_state();
   return this->send_number_state_response(resp);
 }
@@ -702,9 +748,9 @@ void APIConnection::number_command(const NumberCommandRequest &msg) {
 
 #ifdef USE_DATETIME_DATE
 bool APIConnection::send_date_state(datetime::DateEntity *date) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<datetime::DateEntity, &APIConnection::try_send_date_state>(date);
+}
+bool APIConnection::try_send_date_state(datetime::DateEntity *date) {
   DateStateResponse resp{};
   resp.key = date->get_object_id_hash();
   resp.missing_state = !date->has_state();
@@ -739,9 +785,9 @@ void APIConnection::date_command(const DateCommandRequest &msg) {
 
 #ifdef USE_DATETIME_TIME
 bool APIConnection::send_time_state(datetime::TimeEntity *time) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<datetime::TimeEntity, &APIConnection::try_send_time_state>(time);
+}
+bool APIConnection::try_send_time_state(datetime::TimeEntity *time) {
   TimeStateResponse resp{};
   resp.key = time->get_object_id_hash();
   resp.missing_state = !time->has_state();
@@ -776,9 +822,9 @@ void APIConnection::time_command(const TimeCommandRequest &msg) {
 
 #ifdef USE_DATETIME_DATETIME
 bool APIConnection::send_datetime_state(datetime::DateTimeEntity *datetime) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<datetime::DateTimeEntity, &APIConnection::try_send_datetime_state>(datetime);
+}
+bool APIConnection::try_send_datetime_state(datetime::DateTimeEntity *datetime) {
   DateTimeStateResponse resp{};
   resp.key = datetime->get_object_id_hash();
   resp.missing_state = !datetime->has_state();
@@ -813,13 +859,13 @@ void APIConnection::datetime_command(const DateTimeCommandRequest &msg) {
 #endif
 
 #ifdef USE_TEXT
-bool APIConnection::send_text_state(text::Text *text, std::string state) {
-  if (!this->state_subscription_)
-    return false;
-
+bool APIConnection::send_text_state(text::Text *text) {
+  return this->send_state_<text::Text, &APIConnection::try_send_text_state>(text);
+}
+bool APIConnection::try_send_text_state(text::Text *text) {
   TextStateResponse resp{};
   resp.key = text->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = text->state;
   resp.missing_state = !text->has_state();
   return this->send_text_state_response(resp);
 }
@@ -851,13 +897,13 @@ void APIConnection::text_command(const TextCommandRequest &msg) {
 #endif
 
 #ifdef USE_SELECT
-bool APIConnection::send_select_state(select::Select *select, std::string state) {
-  if (!this->state_subscription_)
-    return false;
-
+bool APIConnection::send_select_state(select::Select *select) {
+  return this->send_state_<select::Select, &APIConnection::try_send_select_state>(select);
+}
+bool APIConnection::try_send_select_state(select::Select *select) {
   SelectStateResponse resp{};
   resp.key = select->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = select->state;
   resp.missing_state = !select->has_state();
   return this->send_select_state_response(resp);
 }
@@ -912,13 +958,13 @@ void APIConnection::button_command(const ButtonCommandRequest &msg) {
 #endif
 
 #ifdef USE_LOCK
-bool APIConnection::send_lock_state(lock::Lock *a_lock, lock::LockState state) {
-  if (!this->state_subscription_)
-    return false;
-
+bool APIConnection::send_lock_state(lock::Lock *a_lock) {
+  return this->send_state_<lock::Lock, &APIConnection::try_send_lock_state>(a_lock);
+}
+bool APIConnection::try_send_lock_state(lock::Lock *a_lock) {
   LockStateResponse resp{};
   resp.key = a_lock->get_object_id_hash();
-  resp.state = static_cast<enums::LockState>(state);
+  resp.state = static_cast<enums::LockState>(a_lock->state);
   return this->send_lock_state_response(resp);
 }
 bool APIConnection::send_lock_info(lock::Lock *a_lock) {
@@ -957,9 +1003,9 @@ void APIConnection::lock_command(const LockCommandRequest &msg) {
 
 #ifdef USE_VALVE
 bool APIConnection::send_valve_state(valve::Valve *valve) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<valve::Valve, &APIConnection::try_send_valve_state>(valve);
+}
+bool APIConnection::try_send_valve_state(valve::Valve *valve) {
   ValveStateResponse resp{};
   resp.key = valve->get_object_id_hash();
   resp.position = valve->position;
@@ -999,9 +1045,9 @@ void APIConnection::valve_command(const ValveCommandRequest &msg) {
 
 #ifdef USE_MEDIA_PLAYER
 bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_player) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<media_player::MediaPlayer, &APIConnection::try_send_media_player_state>(media_player);
+}
+bool APIConnection::try_send_media_player_state(media_player::MediaPlayer *media_player) {
   MediaPlayerStateResponse resp{};
   resp.key = media_player->get_object_id_hash();
 
@@ -1205,6 +1251,17 @@ void APIConnection::on_voice_assistant_audio(const VoiceAssistantAudio &msg) {
     voice_assistant::global_voice_assistant->on_audio(msg);
   }
 };
+bool APIConnection::send_voice_assistant_audio_packet(uint8_t *audio, uint16_t size) {
+  // bytes data = 1;
+  uint8_t field_header_size = 1 + ProtoSize::varint(static_cast<uint32_t>(size));
+  if (field_header_size > VOICE_ASSISTANT_AUDIO_HEADER_SIZE - API_MAX_FRAME_HEADER_PADDING)
+    return false;
+  ProtoWriteBuffer header(audio - field_header_size, field_header_size);
+  header.encode_field_raw(1, 2);
+  header.encode_varint_raw(size);
+  // VoiceAssistantAudio - 106
+  return this->send_buffer({audio - field_header_size, field_header_size + static_cast<uint32_t>(size)}, 106);
+}
 void APIConnection::on_voice_assistant_timer_event_response(const VoiceAssistantTimerEventResponse &msg) {
   if (voice_assistant::global_voice_assistant != nullptr) {
     if (voice_assistant::global_voice_assistant->get_api_connection() != this) {
@@ -1265,9 +1322,10 @@ void APIConnection::voice_assistant_set_configuration(const VoiceAssistantSetCon
 
 #ifdef USE_ALARM_CONTROL_PANEL
 bool APIConnection::send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<alarm_control_panel::AlarmControlPanel,
+                           &APIConnection::try_send_alarm_control_panel_state>(a_alarm_control_panel);
+}
+bool APIConnection::try_send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   AlarmControlPanelStateResponse resp{};
   resp.key = a_alarm_control_panel->get_object_id_hash();
   resp.state = static_cast<enums::AlarmControlPanelState>(a_alarm_control_panel->get_state());
@@ -1347,9 +1405,9 @@ bool APIConnection::send_event_info(event::Event *event) {
 
 #ifdef USE_UPDATE
 bool APIConnection::send_update_state(update::UpdateEntity *update) {
-  if (!this->state_subscription_)
-    return false;
-
+  return this->send_state_<update::UpdateEntity, &APIConnection::try_send_update_state>(update);
+}
+bool APIConnection::try_send_update_state(update::UpdateEntity *update) {
   UpdateStateResponse resp{};
   resp.key = update->get_object_id_hash();
   resp.missing_state = !update->has_state();
@@ -1403,16 +1461,43 @@ void APIConnection::update_command(const UpdateCommandRequest &msg) {
 }
 #endif
 
+#ifdef USE_LOOP_PROFILER
+ComponentTimingsResponse APIConnection::get_component_timings(const ComponentTimingsRequest &msg) {
+  ComponentTimingsResponse resp;
+  for (auto *component : App.get_components()) {
+    ComponentTiming timing;
+    timing.source = component->get_component_source();
+    auto &loop = component->get_loop_histogram();
+    for (uint8_t i = 0; i < TimingHistogram::BUCKETS; i++)
+      timing.loop_histogram.push_back(loop.get_count(i));
+    timing.loop_total_us = loop.get_total_us();
+    timing.loop_max_us = loop.get_max_us();
+    auto &scheduler = component->get_scheduler_histogram();
+    for (uint8_t i = 0; i < TimingHistogram::BUCKETS; i++)
+      timing.scheduler_histogram.push_back(scheduler.get_count(i));
+    timing.scheduler_total_us = scheduler.get_total_us();
+    timing.scheduler_max_us = scheduler.get_max_us();
+    resp.components.push_back(std::move(timing));
+  }
+  return resp;
+}
+#endif
+
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
   if (this->log_subscription_ < level)
     return false;
 
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  size_t line_len = strlen(line);
+  uint32_t msg_size = 0;
+  ProtoSize::add_uint32(msg_size, 1, static_cast<uint32_t>(level));
+  ProtoSize::add_string(msg_size, 3, line_len);
+
+  auto buffer = this->create_buffer(msg_size);
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
   // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  buffer.encode_string(3, line, line_len);
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
@@ -1432,6 +1517,8 @@ HelloResponse APIConnection::hello(const HelloRequest &msg) {
   resp.api_version_minor = 10;
   resp.server_info = App.get_name() + " (esphome v" ESPHOME_VERSION ")";
   resp.name = App.get_name();
+  this->batch_states_ = msg.supports_batched_states && this->parent_->get_batch_delay() != 0;
+  resp.batched_states = this->batch_states_;
 
   this->connection_state_ = ConnectionState::CONNECTED;
   return resp;
@@ -1516,9 +1603,100 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
+static bool is_batchable_state(uint32_t message_type) {
+  switch (message_type) {
+    case 21:   // BinarySensorStateResponse
+    case 22:   // CoverStateResponse
+    case 23:   // FanStateResponse
+    case 24:   // LightStateResponse
+    case 25:   // SensorStateResponse
+    case 26:   // SwitchStateResponse
+    case 27:   // TextSensorStateResponse
+    case 47:   // ClimateStateResponse
+    case 50:   // NumberStateResponse
+    case 53:   // SelectStateResponse
+    case 59:   // LockStateResponse
+    case 64:   // MediaPlayerStateResponse
+    case 95:   // AlarmControlPanelStateResponse
+    case 98:   // TextStateResponse
+    case 101:  // DateStateResponse
+    case 104:  // TimeStateResponse
+    case 110:  // ValveStateResponse
+    case 113:  // DateTimeStateResponse
+    case 117:  // UpdateStateResponse
+      return true;
+    default:
+      return false;
+  }
+}
+
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
   if (this->remove_)
     return false;
+  if (this->batch_states_ && is_batchable_state(message_type))
+    return this->add_to_batch_(buffer, message_type);
+  // Keep the order of messages on the wire: anything batched so far goes out first
+  if (!this->batch_buffer_.empty() && !this->flush_batch_())
+    return false;
+  return this->write_buffer_(buffer, message_type);
+}
+
+bool APIConnection::add_to_batch_(ProtoWriteBuffer buffer, uint32_t message_type) {
+  // Keep a batch within a single TCP segment, larger state messages are sent on their own
+  static const size_t MAX_BATCH_PAYLOAD = 1400;
+
+  uint32_t entry_size = 0;
+  ProtoSize::add_uint32(entry_size, 1, message_type);
+  ProtoSize::add_bytes(entry_size, 2, buffer.get_size());
+  uint32_t field_size = 0;
+  // A nested message has the same framing as a bytes field
+  ProtoSize::add_bytes(field_size, 1, entry_size, true);
+  if (field_size > MAX_BATCH_PAYLOAD) {
+    if (!this->batch_buffer_.empty() && !this->flush_batch_())
+      return false;
+    return this->write_buffer_(buffer, message_type);
+  }
+
+  uint8_t header_padding = this->helper_->frame_header_padding();
+  if (!this->batch_buffer_.empty() && this->batch_buffer_.size() - header_padding + field_size > MAX_BATCH_PAYLOAD &&
+      !this->flush_batch_())
+    return false;
+  if (this->batch_buffer_.empty()) {
+    this->batch_buffer_.resize(header_padding);
+    this->batch_started_ = millis();
+  }
+
+  size_t offset = this->batch_buffer_.size();
+  this->batch_buffer_.resize(offset + field_size);
+  // repeated BatchedMessage messages = 1;
+  ProtoWriteBuffer entry{this->batch_buffer_.data() + offset, field_size};
+  entry.encode_field_raw(1, 2);
+  entry.encode_varint_raw(entry_size);
+  // uint32 type = 1;
+  entry.encode_uint32(1, message_type);
+  // bytes data = 2;
+  entry.encode_bytes(2, buffer.get_data(), buffer.get_size());
+  return true;
+}
+
+bool APIConnection::flush_batch_() {
+  if (this->batch_buffer_.empty())
+    return true;
+  uint8_t header_padding = this->helper_->frame_header_padding();
+  size_t payload_size = this->batch_buffer_.size() - header_padding;
+  this->batch_buffer_.resize(this->batch_buffer_.size() + this->helper_->frame_footer_size());
+  // BatchedMessagesResponse - 126
+  bool success = this->write_buffer_({this->batch_buffer_.data() + header_padding, payload_size}, 126);
+  if (success || this->remove_) {
+    this->batch_buffer_.clear();
+  } else {
+    // Socket is busy, keep the batch for the next attempt
+    this->batch_buffer_.resize(header_padding + payload_size);
+  }
+  return success;
+}
+
+bool APIConnection::write_buffer_(ProtoWriteBuffer buffer, uint32_t message_type) {
   if (!this->helper_->can_write_without_blocking()) {
     delay(0);
     APIError err = this->helper_->loop();
@@ -1538,7 +1716,7 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  APIError err = this->helper_->write_protobuf_packet(message_type, buffer);
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -8,12 +8,44 @@
 #include "api_server.h"
 #include "esphome/core/application.h"
 #include "esphome/core/component.h"
+#include "esphome/core/entity_base.h"
 
+#include <unordered_set>
 #include <vector>
 
 namespace esphome {
 namespace api {
 
+class APIConnection;
+
+/** Entity state updates that could not be written to a slow client yet.
+ *
+ * Holds at most one entry per entity. The response is built from the entity's current state when the entry is
+ * finally sent, so intermediate values are skipped and the newest state is always the one delivered.
+ */
+class DeferredStateQueue {
+ public:
+  using send_state_t = bool (*)(APIConnection *, EntityBase *);
+
+  void defer(EntityBase *entity, send_state_t send_state);
+  /// Send the queued states in order until the connection refuses one.
+  void process(APIConnection *conn);
+  bool empty() const { return this->items_.empty(); }
+  void clear() {
+    this->items_.clear();
+    this->pending_.clear();
+  }
+
+ protected:
+  struct Item {
+    EntityBase *entity;
+    send_state_t send_state;
+  };
+  std::vector<Item> items_;
+  /// Entities in items_, so deferring an already queued entity doesn't need a scan.
+  std::unordered_set<EntityBase *> pending_;
+};
+
 class APIConnection : public APIServerConnection {
  public:
   APIConnection(std::unique_ptr<socket::Socket> socket, APIServer *parent);
@@ -21,41 +53,52 @@ class APIConnection : public APIServerConnection {
 
   void start();
   void loop();
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// Whether loop() has work that isn't triggered by incoming data, like iterators, batches or pending writes.
+  bool needs_polling();
+#endif
 
   bool send_list_info_done() {
     ListEntitiesDoneResponse resp;
     return this->send_list_entities_done_response(resp);
   }
 #ifdef USE_BINARY_SENSOR
-  bool send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state);
+  bool send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor);
+  bool try_send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor);
   bool send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor);
 #endif
 #ifdef USE_COVER
   bool send_cover_state(cover::Cover *cover);
+  bool try_send_cover_state(cover::Cover *cover);
   bool send_cover_info(cover::Cover *cover);
   void cover_command(const CoverCommandRequest &msg) override;
 #endif
 #ifdef USE_FAN
   bool send_fan_state(fan::Fan *fan);
+  bool try_send_fan_state(fan::Fan *fan);
   bool send_fan_info(fan::Fan *fan);
   void fan_command(const FanCommandRequest &msg) override;
 #endif
 #ifdef USE_LIGHT
   bool send_light_state(light::LightState *light);
+  bool try_send_light_state(light::LightState *light);
   bool send_light_info(light::LightState *light);
   void light_command(const LightCommandRequest &msg) override;
 #endif
 #ifdef USE_SENSOR
-  bool send_sensor_state(sensor::Sensor *sensor, float state);
+  bool send_sensor_state(sensor::Sensor *sensor);
+  bool try_send_sensor_state(sensor::Sensor *sensor);
   bool send_sensor_info(sensor::Sensor *sensor);
 #endif
 #ifdef USE_SWITCH
-  bool send_switch_state(switch_::Switch *a_switch, bool state);
+  bool send_switch_state(switch_::Switch *a_switch);
+  bool try_send_switch_state(switch_::Switch *a_switch);
   bool send_switch_info(switch_::Switch *a_switch);
   void switch_command(const SwitchCommandRequest &msg) override;
 #endif
 #ifdef USE_TEXT_SENSOR
-  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state);
+  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor);
+  bool try_send_text_sensor_state(text_sensor::TextSensor *text_sensor);
   bool send_text_sensor_info(text_sensor::TextSensor *text_sensor);
 #endif
 #ifdef USE_ESP32_CAMERA
@@ -65,36 +108,43 @@ class APIConnection : public APIServerConnection {
 #endif
 #ifdef USE_CLIMATE
   bool send_climate_state(climate::Climate *climate);
+  bool try_send_climate_state(climate::Climate *climate);
   bool send_climate_info(climate::Climate *climate);
   void climate_command(const ClimateCommandRequest &msg) override;
 #endif
 #ifdef USE_NUMBER
-  bool send_number_state(number::Number *number, float state);
+  bool send_number_state(number::Number *number);
+  bool try_send_number_state(number::Number *number);
   bool send_number_info(number::Number *number);
   void number_command(const NumberCommandRequest &msg) override;
 #endif
 #ifdef USE_DATETIME_DATE
   bool send_date_state(datetime::DateEntity *date);
+  bool try_send_date_state(datetime::DateEntity *date);
   bool send_date_info(datetime::DateEntity *date);
   void date_command(const DateCommandRequest &msg) override;
 #endif
 #ifdef USE_DATETIME_TIME
   bool send_time_state(datetime::TimeEntity *time);
+  bool try_send_time_state(datetime::TimeEntity *time);
   bool send_time_info(datetime::TimeEntity *time);
   void time_command(const TimeCommandRequest &msg) override;
 #endif
 #ifdef USE_DATETIME_DATETIME
   bool send_datetime_state(datetime::DateTimeEntity *datetime);
+  bool try_send_datetime_state(datetime::DateTimeEntity *datetime);
   bool send_datetime_info(datetime::DateTimeEntity *datetime);
   void datetime_command(const DateTimeCommandRequest &msg) override;
 #endif
 #ifdef USE_TEXT
-  bool send_text_state(text::Text *text, std::string state);
+  bool send_text_state(text::Text *text);
+  bool try_send_text_state(text::Text *text);
   bool send_text_info(text::Text *text);
   void text_command(const TextCommandRequest &msg) override;
 #endif
 #ifdef USE_SELECT
-  bool send_select_state(select::Select *select, std::string state);
+  bool send_select_state(select::Select *select);
+  bool try_send_select_state(select::Select *select);
   bool send_select_info(select::Select *select);
   void select_command(const SelectCommandRequest &msg) override;
 #endif
@@ -103,17 +153,20 @@ class APIConnection : public APIServerConnection {
   void button_command(const ButtonCommandRequest &msg) override;
 #endif
 #ifdef USE_LOCK
-  bool send_lock_state(lock::Lock *a_lock, lock::LockState state);
+  bool send_lock_state(lock::Lock *a_lock);
+  bool try_send_lock_state(lock::Lock *a_lock);
   bool send_lock_info(lock::Lock *a_lock);
   void lock_command(const LockCommandRequest &msg) override;
 #endif
 #ifdef USE_VALVE
   bool send_valve_state(valve::Valve *valve);
+  bool try_send_valve_state(valve::Valve *valve);
   bool send_valve_info(valve::Valve *valve);
   void valve_command(const ValveCommandRequest &msg) override;
 #endif
 #ifdef USE_MEDIA_PLAYER
   bool send_media_player_state(media_player::MediaPlayer *media_player);
+  bool try_send_media_player_state(media_player::MediaPlayer *media_player);
   bool send_media_player_info(media_player::MediaPlayer *media_player);
   void media_player_command(const MediaPlayerCommandRequest &msg) override;
 #endif
@@ -156,10 +209,21 @@ class APIConnection : public APIServerConnection {
   VoiceAssistantConfigurationResponse voice_assistant_get_configuration(
       const VoiceAssistantConfigurationRequest &msg) override;
   void voice_assistant_set_configuration(const VoiceAssistantSetConfiguration &msg) override;
+  /** Send audio as a VoiceAssistantAudio message without copying it.
+   *
+   * VOICE_ASSISTANT_AUDIO_HEADER_SIZE bytes in front of audio and API_MAX_FRAME_FOOTER_SIZE bytes after it must belong
+   * to the same allocation, the message is framed (and encrypted) in place around the audio. The buffer contents are
+   * undefined after a successful send. Returns false with the audio left intact if the socket can't take the message
+   * right now, so it can be sent again later.
+   */
+  bool send_voice_assistant_audio_packet(uint8_t *audio, uint16_t size);
+  /// Frame header and the protobuf header of the data field, which holds up to 16383 bytes of audio.
+  static const uint8_t VOICE_ASSISTANT_AUDIO_HEADER_SIZE = API_MAX_FRAME_HEADER_PADDING + 3;
 #endif
 
 #ifdef USE_ALARM_CONTROL_PANEL
   bool send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel);
+  bool try_send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel);
   bool send_alarm_control_panel_info(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel);
   void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) override;
 #endif
@@ -171,10 +235,15 @@ class APIConnection : public APIServerConnection {
 
 #ifdef USE_UPDATE
   bool send_update_state(update::UpdateEntity *update);
+  bool try_send_update_state(update::UpdateEntity *update);
   bool send_update_info(update::UpdateEntity *update);
   void update_command(const UpdateCommandRequest &msg) override;
 #endif
 
+#ifdef USE_LOOP_PROFILER
+  ComponentTimingsResponse get_component_timings(const ComponentTimingsRequest &msg) override;
+#endif
+
   void on_disconnect_response(const DisconnectResponse &value) override;
   void on_ping_response(const PingResponse &value) override {
     // we initiated ping
@@ -217,10 +286,13 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t size) override {
     // FIXME: ensure no recursive writes can happen
-    this->proto_write_buffer_.clear();
-    return {&this->proto_write_buffer_};
+    // Reserve room for the frame header and footer around the payload, so the frame helper can finish the frame
+    // in place instead of copying the payload
+    uint8_t header_padding = this->helper_->frame_header_padding();
+    this->proto_write_buffer_.resize(header_padding + size + this->helper_->frame_footer_size());
+    return {this->proto_write_buffer_.data() + header_padding, size};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
 
@@ -231,6 +303,31 @@ class APIConnection : public APIServerConnection {
 
   bool send_(const void *buf, size_t len, bool force);
 
+  template<typename T, bool (APIConnection::*TrySend)(T *)>
+  static bool deferred_send_state_(APIConnection *conn, EntityBase *entity) {
+    return (conn->*TrySend)(static_cast<T *>(entity));
+  }
+  /** Send the state of entity now, or queue it if the socket is busy or older states are still queued.
+   *
+   * Returns whether the state was written or queued. A queued state is sent from loop() and must not be retried by the
+   * caller, otherwise the initial state iterator would stall on it and send it twice.
+   */
+  template<typename T, bool (APIConnection::*TrySend)(T *)> bool send_state_(T *entity) {
+    if (!this->state_subscription_)
+      return false;
+    if (this->deferred_states_.empty() && (this->*TrySend)(entity))
+      return true;
+    this->deferred_states_.defer(entity, &APIConnection::deferred_send_state_<T, TrySend>);
+    return true;
+  }
+
+  /// Write a single message frame, without batching.
+  bool write_buffer_(ProtoWriteBuffer buffer, uint32_t message_type);
+  /// Append an encoded state response to the pending BatchedMessagesResponse.
+  bool add_to_batch_(ProtoWriteBuffer buffer, uint32_t message_type);
+  /// Send the pending BatchedMessagesResponse, if any.
+  bool flush_batch_();
+
   enum class ConnectionState {
     WAITING_FOR_HELLO,
     CONNECTED,
@@ -239,9 +336,14 @@ class APIConnection : public APIServerConnection {
 
   bool remove_{false};
 
-  // Buffer used to encode proto messages
+  // Buffer holding the frame of the message being sent, proto messages are encoded directly into it
   // Re-use to prevent allocations
   std::vector<uint8_t> proto_write_buffer_;
+  // Frame of the BatchedMessagesResponse being collected, starting with room for the frame header
+  std::vector<uint8_t> batch_buffer_;
+  uint32_t batch_started_{0};
+  // Client can decode BatchedMessagesResponse and batching is enabled on the server
+  bool batch_states_{false};
   std::unique_ptr<APIFrameHelper> helper_;
 
   std::string client_info_;
@@ -254,6 +356,7 @@ class APIConnection : public APIServerConnection {
 #endif
 
   bool state_subscription_{false};
+  DeferredStateQueue deferred_states_;
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
   uint32_t last_traffic_;
   uint32_t next_ping_retry_{0};
@@ -12,6 +12,7 @@
 
 #include "api_noise_context.h"
 #include "esphome/components/socket/socket.h"
+#include "proto.h"
 
 namespace esphome {
 namespace api {
@@ -30,6 +31,11 @@ struct PacketBuffer {
   uint8_t data_len;
 };
 
+/// Largest frame_header_padding() of all frame helpers, for buffers that are framed before the connection is known.
+static const uint8_t API_MAX_FRAME_HEADER_PADDING = 7;
+/// Largest frame_footer_size() of all frame helpers.
+static const uint8_t API_MAX_FRAME_FOOTER_SIZE = 16;
+
 enum class APIError : int {
   OK = 0,
   WOULD_BLOCK = 1001,
@@ -65,7 +71,16 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /** Send a packet whose payload was encoded into buffer.
+   *
+   * frame_header_padding() bytes in front of the payload and frame_footer_size() bytes after it must belong to the
+   * same allocation, the frame is completed in place around the payload.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) = 0;
+  /// Number of bytes to reserve in front of a payload for the frame header.
+  virtual uint8_t frame_header_padding() = 0;
+  /// Number of bytes to reserve after a payload for the frame footer.
+  virtual uint8_t frame_footer_size() = 0;
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
@@ -84,7 +99,11 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  // 3 byte frame header (indicator and encrypted size) and 4 byte message header (type and length)
+  uint8_t frame_header_padding() override { return 7; }
+  // ChaChaPoly authentication tag
+  uint8_t frame_footer_size() override { return 16; }
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -147,7 +166,10 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  // Indicator byte, then the payload length (up to 3 varint bytes) and the message type (up to 2 varint bytes)
+  uint8_t frame_header_padding() override { return 6; }
+  uint8_t frame_footer_size() override { return 0; }
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -603,6 +603,10 @@ bool HelloRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
       this->api_version_minor = value.as_uint32();
       return true;
     }
+    case 4: {
+      this->supports_batched_states = value.as_bool();
+      return true;
+    }
     default:
       return false;
   }
@@ -621,6 +625,13 @@ void HelloRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->client_info);
   buffer.encode_uint32(2, this->api_version_major);
   buffer.encode_uint32(3, this->api_version_minor);
+  buffer.encode_bool(4, this->supports_batched_states);
+}
+void HelloRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->client_info);
+  ProtoSize::add_uint32(total_size, 2, this->api_version_major);
+  ProtoSize::add_uint32(total_size, 3, this->api_version_minor);
+  ProtoSize::add_bool(total_size, 4, this->supports_batched_states);
 }
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HelloRequest::dump_to(std::string &out) const {
@@ -639,6 +650,10 @@ void HelloRequest::dump_to(std::string &out) const {
   sprintf(buffer, "%" PRIu32, this->api_version_minor);
   out.append(buffer);
   out.append("\n");
+
+  out.append("  supports_batched_states: ");
+  out.append(YESNO(this->supports_batched_states));
+  out.append("\n");
   out.append("}");
 }
 #endif
@@ -652,6 +667,10 @@ bool HelloResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
       this->api_version_minor = value.as_uint32();
       return true;
     }
+    case 5: {
+      this->batched_states = value.as_bool();
+      return true;
+    }
     default:
       return false;
   }
@@ -675,6 +694,14 @@ void HelloResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->api_version_minor);
   buffer.encode_string(3, this->server_info);
   buffer.encode_string(4, this->name);
+  buffer.encode_bool(5, this->batched_states);
+}
+void HelloResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->api_version_major);
+  ProtoSize::add_uint32(total_size, 2, this->api_version_minor);
+  ProtoSize::add_string(total_size, 3, this->server_info);
+  ProtoSize::add_string(total_size, 4, this->name);
+  ProtoSize::add_bool(total_size, 5, this->batched_states);
 }
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HelloResponse::dump_to(std::string &out) const {
@@ -697,6 +724,10 @@ void HelloResponse::dump_to(std::string &out) const {
   out.append("  name: ");
   out.append("'").append(this->name).append("'");
   out.append("\n");
+
+  out.append("  batched_states: ");
+  out.append(YESNO(this->batched_states));
+  out.append("\n");
   out.append("}");
 }
 #endif
@@ -711,6 +742,9 @@ bool ConnectRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value
   }
 }
 void ConnectRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_string(1, this->password); }
+void ConnectRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->password);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ConnectRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -732,6 +766,9 @@ bool ConnectResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   }
 }
 void ConnectResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->invalid_password); }
+void ConnectResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->invalid_password);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ConnectResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -743,22 +780,27 @@ void ConnectResponse::dump_to(std::string &out) const {
 }
 #endif
 void DisconnectRequest::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectRequest::dump_to(std::string &out) const { out.append("DisconnectRequest {}"); }
 #endif
 void DisconnectResponse::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectResponse::dump_to(std::string &out) const { out.append("DisconnectResponse {}"); }
 #endif
 void PingRequest::encode(ProtoWriteBuffer buffer) const {}
+void PingRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingRequest::dump_to(std::string &out) const { out.append("PingRequest {}"); }
 #endif
 void PingResponse::encode(ProtoWriteBuffer buffer) const {}
+void PingResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingResponse::dump_to(std::string &out) const { out.append("PingResponse {}"); }
 #endif
 void DeviceInfoRequest::encode(ProtoWriteBuffer buffer) const {}
+void DeviceInfoRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DeviceInfoRequest::dump_to(std::string &out) const { out.append("DeviceInfoRequest {}"); }
 #endif
@@ -861,6 +903,25 @@ void DeviceInfoResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(17, this->voice_assistant_feature_flags);
   buffer.encode_string(16, this->suggested_area);
 }
+void DeviceInfoResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->uses_password);
+  ProtoSize::add_string(total_size, 2, this->name);
+  ProtoSize::add_string(total_size, 3, this->mac_address);
+  ProtoSize::add_string(total_size, 4, this->esphome_version);
+  ProtoSize::add_string(total_size, 5, this->compilation_time);
+  ProtoSize::add_string(total_size, 6, this->model);
+  ProtoSize::add_bool(total_size, 7, this->has_deep_sleep);
+  ProtoSize::add_string(total_size, 8, this->project_name);
+  ProtoSize::add_string(total_size, 9, this->project_version);
+  ProtoSize::add_uint32(total_size, 10, this->webserver_port);
+  ProtoSize::add_uint32(total_size, 11, this->legacy_bluetooth_proxy_version);
+  ProtoSize::add_uint32(total_size, 15, this->bluetooth_proxy_feature_flags);
+  ProtoSize::add_string(total_size, 12, this->manufacturer);
+  ProtoSize::add_string(total_size, 13, this->friendly_name);
+  ProtoSize::add_uint32(total_size, 14, this->legacy_voice_assistant_version);
+  ProtoSize::add_uint32(total_size, 17, this->voice_assistant_feature_flags);
+  ProtoSize::add_string(total_size, 16, this->suggested_area);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DeviceInfoResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -941,14 +1002,17 @@ void DeviceInfoResponse::dump_to(std::string &out) const {
 }
 #endif
 void ListEntitiesRequest::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesRequest::dump_to(std::string &out) const { out.append("ListEntitiesRequest {}"); }
 #endif
 void ListEntitiesDoneResponse::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesDoneResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesDoneResponse::dump_to(std::string &out) const { out.append("ListEntitiesDoneResponse {}"); }
 #endif
 void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeStatesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeStatesRequest::dump_to(std::string &out) const { out.append("SubscribeStatesRequest {}"); }
 #endif
@@ -1017,6 +1081,17 @@ void ListEntitiesBinarySensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(8, this->icon);
   buffer.encode_enum<enums::EntityCategory>(9, this->entity_category);
 }
+void ListEntitiesBinarySensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->device_class);
+  ProtoSize::add_bool(total_size, 6, this->is_status_binary_sensor);
+  ProtoSize::add_bool(total_size, 7, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 8, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 9, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesBinarySensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1089,6 +1164,11 @@ void BinarySensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void BinarySensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BinarySensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1188,6 +1268,20 @@ void ListEntitiesCoverResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(11, this->entity_category);
   buffer.encode_bool(12, this->supports_stop);
 }
+void ListEntitiesCoverResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_bool(total_size, 5, this->assumed_state);
+  ProtoSize::add_bool(total_size, 6, this->supports_position);
+  ProtoSize::add_bool(total_size, 7, this->supports_tilt);
+  ProtoSize::add_string(total_size, 8, this->device_class);
+  ProtoSize::add_bool(total_size, 9, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 10, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 11, this->entity_category);
+  ProtoSize::add_bool(total_size, 12, this->supports_stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesCoverResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1282,6 +1376,13 @@ void CoverStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(4, this->tilt);
   buffer.encode_enum<enums::CoverOperation>(5, this->current_operation);
 }
+void CoverStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::LegacyCoverState>(total_size, 2, this->legacy_state);
+  ProtoSize::add_float(total_size, 3, this->position);
+  ProtoSize::add_float(total_size, 4, this->tilt);
+  ProtoSize::add_enum<enums::CoverOperation>(total_size, 5, this->current_operation);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CoverStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1365,6 +1466,16 @@ void CoverCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(7, this->tilt);
   buffer.encode_bool(8, this->stop);
 }
+void CoverCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_legacy_command);
+  ProtoSize::add_enum<enums::LegacyCoverCommand>(total_size, 3, this->legacy_command);
+  ProtoSize::add_bool(total_size, 4, this->has_position);
+  ProtoSize::add_float(total_size, 5, this->position);
+  ProtoSize::add_bool(total_size, 6, this->has_tilt);
+  ProtoSize::add_float(total_size, 7, this->tilt);
+  ProtoSize::add_bool(total_size, 8, this->stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CoverCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1488,6 +1599,22 @@ void ListEntitiesFanResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(12, it, true);
   }
 }
+void ListEntitiesFanResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_bool(total_size, 5, this->supports_oscillation);
+  ProtoSize::add_bool(total_size, 6, this->supports_speed);
+  ProtoSize::add_bool(total_size, 7, this->supports_direction);
+  ProtoSize::add_int32(total_size, 8, this->supported_speed_count);
+  ProtoSize::add_bool(total_size, 9, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 10, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 11, this->entity_category);
+  for (auto &it : this->supported_preset_modes) {
+    ProtoSize::add_string(total_size, 12, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesFanResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1601,6 +1728,15 @@ void FanStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_int32(6, this->speed_level);
   buffer.encode_string(7, this->preset_mode);
 }
+void FanStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->oscillating);
+  ProtoSize::add_enum<enums::FanSpeed>(total_size, 4, this->speed);
+  ProtoSize::add_enum<enums::FanDirection>(total_size, 5, this->direction);
+  ProtoSize::add_int32(total_size, 6, this->speed_level);
+  ProtoSize::add_string(total_size, 7, this->preset_mode);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void FanStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1722,6 +1858,21 @@ void FanCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(12, this->has_preset_mode);
   buffer.encode_string(13, this->preset_mode);
 }
+void FanCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_state);
+  ProtoSize::add_bool(total_size, 3, this->state);
+  ProtoSize::add_bool(total_size, 4, this->has_speed);
+  ProtoSize::add_enum<enums::FanSpeed>(total_size, 5, this->speed);
+  ProtoSize::add_bool(total_size, 6, this->has_oscillating);
+  ProtoSize::add_bool(total_size, 7, this->oscillating);
+  ProtoSize::add_bool(total_size, 8, this->has_direction);
+  ProtoSize::add_enum<enums::FanDirection>(total_size, 9, this->direction);
+  ProtoSize::add_bool(total_size, 10, this->has_speed_level);
+  ProtoSize::add_int32(total_size, 11, this->speed_level);
+  ProtoSize::add_bool(total_size, 12, this->has_preset_mode);
+  ProtoSize::add_string(total_size, 13, this->preset_mode);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void FanCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1881,6 +2032,27 @@ void ListEntitiesLightResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(14, this->icon);
   buffer.encode_enum<enums::EntityCategory>(15, this->entity_category);
 }
+void ListEntitiesLightResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  for (auto &it : this->supported_color_modes) {
+    ProtoSize::add_enum<enums::ColorMode>(total_size, 12, it, true);
+  }
+  ProtoSize::add_bool(total_size, 5, this->legacy_supports_brightness);
+  ProtoSize::add_bool(total_size, 6, this->legacy_supports_rgb);
+  ProtoSize::add_bool(total_size, 7, this->legacy_supports_white_value);
+  ProtoSize::add_bool(total_size, 8, this->legacy_supports_color_temperature);
+  ProtoSize::add_float(total_size, 9, this->min_mireds);
+  ProtoSize::add_float(total_size, 10, this->max_mireds);
+  for (auto &it : this->effects) {
+    ProtoSize::add_string(total_size, 11, it, true);
+  }
+  ProtoSize::add_bool(total_size, 13, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 14, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 15, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesLightResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2039,6 +2211,21 @@ void LightStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(13, this->warm_white);
   buffer.encode_string(9, this->effect);
 }
+void LightStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+  ProtoSize::add_float(total_size, 3, this->brightness);
+  ProtoSize::add_enum<enums::ColorMode>(total_size, 11, this->color_mode);
+  ProtoSize::add_float(total_size, 10, this->color_brightness);
+  ProtoSize::add_float(total_size, 4, this->red);
+  ProtoSize::add_float(total_size, 5, this->green);
+  ProtoSize::add_float(total_size, 6, this->blue);
+  ProtoSize::add_float(total_size, 7, this->white);
+  ProtoSize::add_float(total_size, 8, this->color_temperature);
+  ProtoSize::add_float(total_size, 12, this->cold_white);
+  ProtoSize::add_float(total_size, 13, this->warm_white);
+  ProtoSize::add_string(total_size, 9, this->effect);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LightStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2262,6 +2449,35 @@ void LightCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(18, this->has_effect);
   buffer.encode_string(19, this->effect);
 }
+void LightCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_state);
+  ProtoSize::add_bool(total_size, 3, this->state);
+  ProtoSize::add_bool(total_size, 4, this->has_brightness);
+  ProtoSize::add_float(total_size, 5, this->brightness);
+  ProtoSize::add_bool(total_size, 22, this->has_color_mode);
+  ProtoSize::add_enum<enums::ColorMode>(total_size, 23, this->color_mode);
+  ProtoSize::add_bool(total_size, 20, this->has_color_brightness);
+  ProtoSize::add_float(total_size, 21, this->color_brightness);
+  ProtoSize::add_bool(total_size, 6, this->has_rgb);
+  ProtoSize::add_float(total_size, 7, this->red);
+  ProtoSize::add_float(total_size, 8, this->green);
+  ProtoSize::add_float(total_size, 9, this->blue);
+  ProtoSize::add_bool(total_size, 10, this->has_white);
+  ProtoSize::add_float(total_size, 11, this->white);
+  ProtoSize::add_bool(total_size, 12, this->has_color_temperature);
+  ProtoSize::add_float(total_size, 13, this->color_temperature);
+  ProtoSize::add_bool(total_size, 24, this->has_cold_white);
+  ProtoSize::add_float(total_size, 25, this->cold_white);
+  ProtoSize::add_bool(total_size, 26, this->has_warm_white);
+  ProtoSize::add_float(total_size, 27, this->warm_white);
+  ProtoSize::add_bool(total_size, 14, this->has_transition_length);
+  ProtoSize::add_uint32(total_size, 15, this->transition_length);
+  ProtoSize::add_bool(total_size, 16, this->has_flash_length);
+  ProtoSize::add_uint32(total_size, 17, this->flash_length);
+  ProtoSize::add_bool(total_size, 18, this->has_effect);
+  ProtoSize::add_string(total_size, 19, this->effect);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LightCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2473,6 +2689,21 @@ void ListEntitiesSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(12, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(13, this->entity_category);
 }
+void ListEntitiesSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_string(total_size, 6, this->unit_of_measurement);
+  ProtoSize::add_int32(total_size, 7, this->accuracy_decimals);
+  ProtoSize::add_bool(total_size, 8, this->force_update);
+  ProtoSize::add_string(total_size, 9, this->device_class);
+  ProtoSize::add_enum<enums::SensorStateClass>(total_size, 10, this->state_class);
+  ProtoSize::add_enum<enums::SensorLastResetType>(total_size, 11, this->legacy_last_reset_type);
+  ProtoSize::add_bool(total_size, 12, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 13, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2562,6 +2793,11 @@ void SensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void SensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_float(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2647,6 +2883,17 @@ void ListEntitiesSwitchResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(8, this->entity_category);
   buffer.encode_string(9, this->device_class);
 }
+void ListEntitiesSwitchResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->assumed_state);
+  ProtoSize::add_bool(total_size, 7, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 8, this->entity_category);
+  ProtoSize::add_string(total_size, 9, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSwitchResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2714,6 +2961,10 @@ void SwitchStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SwitchStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2753,6 +3004,10 @@ void SwitchCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SwitchCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2828,6 +3083,16 @@ void ListEntitiesTextSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_string(8, this->device_class);
 }
+void ListEntitiesTextSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_string(total_size, 8, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesTextSensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2902,6 +3167,11 @@ void TextSensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void TextSensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextSensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2939,6 +3209,10 @@ void SubscribeLogsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_bool(2, this->dump_config);
 }
+void SubscribeLogsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_bool(total_size, 2, this->dump_config);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2982,6 +3256,11 @@ void SubscribeLogsResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(3, this->message);
   buffer.encode_bool(4, this->send_failed);
 }
+void SubscribeLogsResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_string(total_size, 3, this->message);
+  ProtoSize::add_bool(total_size, 4, this->send_failed);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3001,6 +3280,7 @@ void SubscribeLogsResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeHomeassistantServicesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeassistantServicesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeassistantServicesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeassistantServicesRequest {}");
@@ -3024,6 +3304,10 @@ void HomeassistantServiceMap::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->key);
   buffer.encode_string(2, this->value);
 }
+void HomeassistantServiceMap::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->value);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeassistantServiceMap::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3083,6 +3367,19 @@ void HomeassistantServiceResponse::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_bool(5, this->is_event);
 }
+void HomeassistantServiceResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->service);
+  for (auto &it : this->data) {
+    ProtoSize::add_message<HomeassistantServiceMap>(total_size, 2, it, true);
+  }
+  for (auto &it : this->data_template) {
+    ProtoSize::add_message<HomeassistantServiceMap>(total_size, 3, it, true);
+  }
+  for (auto &it : this->variables) {
+    ProtoSize::add_message<HomeassistantServiceMap>(total_size, 4, it, true);
+  }
+  ProtoSize::add_bool(total_size, 5, this->is_event);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeassistantServiceResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3116,6 +3413,7 @@ void HomeassistantServiceResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeHomeAssistantStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeAssistantStatesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeAssistantStatesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeAssistantStatesRequest {}");
@@ -3150,6 +3448,11 @@ void SubscribeHomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const
   buffer.encode_string(2, this->attribute);
   buffer.encode_bool(3, this->once);
 }
+void SubscribeHomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->entity_id);
+  ProtoSize::add_string(total_size, 2, this->attribute);
+  ProtoSize::add_bool(total_size, 3, this->once);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeAssistantStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3171,15 +3474,15 @@ void SubscribeHomeAssistantStateResponse::dump_to(std::string &out) const {
 bool HomeAssistantStateResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->entity_id = value.as_string();
+      this->entity_id = value.as_string_ref();
       return true;
     }
     case 2: {
-      this->state = value.as_string();
+      this->state = value.as_string_ref();
       return true;
     }
     case 3: {
-      this->attribute = value.as_string();
+      this->attribute = value.as_string_ref();
       return true;
     }
     default:
@@ -3191,25 +3494,31 @@ void HomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_string(3, this->attribute);
 }
+void HomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->entity_id);
+  ProtoSize::add_string(total_size, 2, this->state);
+  ProtoSize::add_string(total_size, 3, this->attribute);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeAssistantStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("HomeAssistantStateResponse {\n");
   out.append("  entity_id: ");
-  out.append("'").append(this->entity_id).append("'");
+  out.append("'").append(this->entity_id.c_str(), this->entity_id.size()).append("'");
   out.append("\n");
 
   out.append("  state: ");
-  out.append("'").append(this->state).append("'");
+  out.append("'").append(this->state.c_str(), this->state.size()).append("'");
   out.append("\n");
 
   out.append("  attribute: ");
-  out.append("'").append(this->attribute).append("'");
+  out.append("'").append(this->attribute.c_str(), this->attribute.size()).append("'");
   out.append("\n");
   out.append("}");
 }
 #endif
 void GetTimeRequest::encode(ProtoWriteBuffer buffer) const {}
+void GetTimeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void GetTimeRequest::dump_to(std::string &out) const { out.append("GetTimeRequest {}"); }
 #endif
@@ -3224,6 +3533,9 @@ bool GetTimeResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
   }
 }
 void GetTimeResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->epoch_seconds); }
+void GetTimeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->epoch_seconds);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void GetTimeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3259,6 +3571,10 @@ void ListEntitiesServicesArgument::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_enum<enums::ServiceArgType>(2, this->type);
 }
+void ListEntitiesServicesArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->name);
+  ProtoSize::add_enum<enums::ServiceArgType>(total_size, 2, this->type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesServicesArgument::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3304,6 +3620,13 @@ void ListEntitiesServicesResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ListEntitiesServicesArgument>(3, it, true);
   }
 }
+void ListEntitiesServicesResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->name);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  for (auto &it : this->args) {
+    ProtoSize::add_message<ListEntitiesServicesArgument>(total_size, 3, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesServicesResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3398,6 +3721,25 @@ void ExecuteServiceArgument::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(9, it, true);
   }
 }
+void ExecuteServiceArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->bool_);
+  ProtoSize::add_int32(total_size, 2, this->legacy_int);
+  ProtoSize::add_float(total_size, 3, this->float_);
+  ProtoSize::add_string(total_size, 4, this->string_);
+  ProtoSize::add_sint32(total_size, 5, this->int_);
+  for (auto it : this->bool_array) {
+    ProtoSize::add_bool(total_size, 6, it, true);
+  }
+  for (auto &it : this->int_array) {
+    ProtoSize::add_sint32(total_size, 7, it, true);
+  }
+  for (auto &it : this->float_array) {
+    ProtoSize::add_float(total_size, 8, it, true);
+  }
+  for (auto &it : this->string_array) {
+    ProtoSize::add_string(total_size, 9, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ExecuteServiceArgument::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3479,6 +3821,12 @@ void ExecuteServiceRequest::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ExecuteServiceArgument>(2, it, true);
   }
 }
+void ExecuteServiceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  for (auto &it : this->args) {
+    ProtoSize::add_message<ExecuteServiceArgument>(total_size, 2, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ExecuteServiceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3551,6 +3899,15 @@ void ListEntitiesCameraResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(6, this->icon);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesCameraResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_bool(total_size, 5, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 6, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesCameraResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3621,6 +3978,11 @@ void CameraImageResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->data);
   buffer.encode_bool(3, this->done);
 }
+void CameraImageResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->data);
+  ProtoSize::add_bool(total_size, 3, this->done);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CameraImageResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3658,6 +4020,10 @@ void CameraImageRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(1, this->single);
   buffer.encode_bool(2, this->stream);
 }
+void CameraImageRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->single);
+  ProtoSize::add_bool(total_size, 2, this->stream);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CameraImageRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3829,6 +4195,45 @@ void ListEntitiesClimateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(24, this->visual_min_humidity);
   buffer.encode_float(25, this->visual_max_humidity);
 }
+void ListEntitiesClimateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_bool(total_size, 5, this->supports_current_temperature);
+  ProtoSize::add_bool(total_size, 6, this->supports_two_point_target_temperature);
+  for (auto &it : this->supported_modes) {
+    ProtoSize::add_enum<enums::ClimateMode>(total_size, 7, it, true);
+  }
+  ProtoSize::add_float(total_size, 8, this->visual_min_temperature);
+  ProtoSize::add_float(total_size, 9, this->visual_max_temperature);
+  ProtoSize::add_float(total_size, 10, this->visual_target_temperature_step);
+  ProtoSize::add_bool(total_size, 11, this->legacy_supports_away);
+  ProtoSize::add_bool(total_size, 12, this->supports_action);
+  for (auto &it : this->supported_fan_modes) {
+    ProtoSize::add_enum<enums::ClimateFanMode>(total_size, 13, it, true);
+  }
+  for (auto &it : this->supported_swing_modes) {
+    ProtoSize::add_enum<enums::ClimateSwingMode>(total_size, 14, it, true);
+  }
+  for (auto &it : this->supported_custom_fan_modes) {
+    ProtoSize::add_string(total_size, 15, it, true);
+  }
+  for (auto &it : this->supported_presets) {
+    ProtoSize::add_enum<enums::ClimatePreset>(total_size, 16, it, true);
+  }
+  for (auto &it : this->supported_custom_presets) {
+    ProtoSize::add_string(total_size, 17, it, true);
+  }
+  ProtoSize::add_bool(total_size, 18, this->disabled_by_default);
+  ProtoSize::add_string(total_size, 19, this->icon);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 20, this->entity_category);
+  ProtoSize::add_float(total_size, 21, this->visual_current_temperature_step);
+  ProtoSize::add_bool(total_size, 22, this->supports_current_humidity);
+  ProtoSize::add_bool(total_size, 23, this->supports_target_humidity);
+  ProtoSize::add_float(total_size, 24, this->visual_min_humidity);
+  ProtoSize::add_float(total_size, 25, this->visual_max_humidity);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesClimateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4049,6 +4454,23 @@ void ClimateStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(14, this->current_humidity);
   buffer.encode_float(15, this->target_humidity);
 }
+void ClimateStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::ClimateMode>(total_size, 2, this->mode);
+  ProtoSize::add_float(total_size, 3, this->current_temperature);
+  ProtoSize::add_float(total_size, 4, this->target_temperature);
+  ProtoSize::add_float(total_size, 5, this->target_temperature_low);
+  ProtoSize::add_float(total_size, 6, this->target_temperature_high);
+  ProtoSize::add_bool(total_size, 7, this->unused_legacy_away);
+  ProtoSize::add_enum<enums::ClimateAction>(total_size, 8, this->action);
+  ProtoSize::add_enum<enums::ClimateFanMode>(total_size, 9, this->fan_mode);
+  ProtoSize::add_enum<enums::ClimateSwingMode>(total_size, 10, this->swing_mode);
+  ProtoSize::add_string(total_size, 11, this->custom_fan_mode);
+  ProtoSize::add_enum<enums::ClimatePreset>(total_size, 12, this->preset);
+  ProtoSize::add_string(total_size, 13, this->custom_preset);
+  ProtoSize::add_float(total_size, 14, this->current_humidity);
+  ProtoSize::add_float(total_size, 15, this->target_humidity);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ClimateStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4257,6 +4679,31 @@ void ClimateCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(22, this->has_target_humidity);
   buffer.encode_float(23, this->target_humidity);
 }
+void ClimateCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_mode);
+  ProtoSize::add_enum<enums::ClimateMode>(total_size, 3, this->mode);
+  ProtoSize::add_bool(total_size, 4, this->has_target_temperature);
+  ProtoSize::add_float(total_size, 5, this->target_temperature);
+  ProtoSize::add_bool(total_size, 6, this->has_target_temperature_low);
+  ProtoSize::add_float(total_size, 7, this->target_temperature_low);
+  ProtoSize::add_bool(total_size, 8, this->has_target_temperature_high);
+  ProtoSize::add_float(total_size, 9, this->target_temperature_high);
+  ProtoSize::add_bool(total_size, 10, this->unused_has_legacy_away);
+  ProtoSize::add_bool(total_size, 11, this->unused_legacy_away);
+  ProtoSize::add_bool(total_size, 12, this->has_fan_mode);
+  ProtoSize::add_enum<enums::ClimateFanMode>(total_size, 13, this->fan_mode);
+  ProtoSize::add_bool(total_size, 14, this->has_swing_mode);
+  ProtoSize::add_enum<enums::ClimateSwingMode>(total_size, 15, this->swing_mode);
+  ProtoSize::add_bool(total_size, 16, this->has_custom_fan_mode);
+  ProtoSize::add_string(total_size, 17, this->custom_fan_mode);
+  ProtoSize::add_bool(total_size, 18, this->has_preset);
+  ProtoSize::add_enum<enums::ClimatePreset>(total_size, 19, this->preset);
+  ProtoSize::add_bool(total_size, 20, this->has_custom_preset);
+  ProtoSize::add_string(total_size, 21, this->custom_preset);
+  ProtoSize::add_bool(total_size, 22, this->has_target_humidity);
+  ProtoSize::add_float(total_size, 23, this->target_humidity);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ClimateCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4445,6 +4892,21 @@ void ListEntitiesNumberResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::NumberMode>(12, this->mode);
   buffer.encode_string(13, this->device_class);
 }
+void ListEntitiesNumberResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_float(total_size, 6, this->min_value);
+  ProtoSize::add_float(total_size, 7, this->max_value);
+  ProtoSize::add_float(total_size, 8, this->step);
+  ProtoSize::add_bool(total_size, 9, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 10, this->entity_category);
+  ProtoSize::add_string(total_size, 11, this->unit_of_measurement);
+  ProtoSize::add_enum<enums::NumberMode>(total_size, 12, this->mode);
+  ProtoSize::add_string(total_size, 13, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesNumberResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4536,6 +4998,11 @@ void NumberStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void NumberStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_float(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void NumberStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4574,6 +5041,10 @@ void NumberCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->state);
 }
+void NumberCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_float(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void NumberCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4652,6 +5123,18 @@ void ListEntitiesSelectResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(7, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(8, this->entity_category);
 }
+void ListEntitiesSelectResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  for (auto &it : this->options) {
+    ProtoSize::add_string(total_size, 6, it, true);
+  }
+  ProtoSize::add_bool(total_size, 7, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 8, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSelectResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4728,6 +5211,11 @@ void SelectStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void SelectStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SelectStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4771,6 +5259,10 @@ void SelectCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
 }
+void SelectCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SelectCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4861,6 +5353,19 @@ void ListEntitiesLockResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(10, this->requires_code);
   buffer.encode_string(11, this->code_format);
 }
+void ListEntitiesLockResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_bool(total_size, 8, this->assumed_state);
+  ProtoSize::add_bool(total_size, 9, this->supports_open);
+  ProtoSize::add_bool(total_size, 10, this->requires_code);
+  ProtoSize::add_string(total_size, 11, this->code_format);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesLockResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4936,6 +5441,10 @@ void LockStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::LockState>(2, this->state);
 }
+void LockStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::LockState>(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LockStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4991,6 +5500,12 @@ void LockCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->has_code);
   buffer.encode_string(4, this->code);
 }
+void LockCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::LockCommand>(total_size, 2, this->command);
+  ProtoSize::add_bool(total_size, 3, this->has_code);
+  ProtoSize::add_string(total_size, 4, this->code);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LockCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5074,6 +5589,16 @@ void ListEntitiesButtonResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_string(8, this->device_class);
 }
+void ListEntitiesButtonResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_string(total_size, 8, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesButtonResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5124,6 +5649,9 @@ bool ButtonCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
   }
 }
 void ButtonCommandRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->key); }
+void ButtonCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ButtonCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5174,6 +5702,13 @@ void MediaPlayerSupportedFormat::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::MediaPlayerFormatPurpose>(4, this->purpose);
   buffer.encode_uint32(5, this->sample_bytes);
 }
+void MediaPlayerSupportedFormat::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->format);
+  ProtoSize::add_uint32(total_size, 2, this->sample_rate);
+  ProtoSize::add_uint32(total_size, 3, this->num_channels);
+  ProtoSize::add_enum<enums::MediaPlayerFormatPurpose>(total_size, 4, this->purpose);
+  ProtoSize::add_uint32(total_size, 5, this->sample_bytes);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void MediaPlayerSupportedFormat::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5270,6 +5805,19 @@ void ListEntitiesMediaPlayerResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<MediaPlayerSupportedFormat>(9, it, true);
   }
 }
+void ListEntitiesMediaPlayerResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_bool(total_size, 8, this->supports_pause);
+  for (auto &it : this->supported_formats) {
+    ProtoSize::add_message<MediaPlayerSupportedFormat>(total_size, 9, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesMediaPlayerResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5349,6 +5897,12 @@ void MediaPlayerStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(3, this->volume);
   buffer.encode_bool(4, this->muted);
 }
+void MediaPlayerStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::MediaPlayerState>(total_size, 2, this->state);
+  ProtoSize::add_float(total_size, 3, this->volume);
+  ProtoSize::add_bool(total_size, 4, this->muted);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void MediaPlayerStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5438,6 +5992,17 @@ void MediaPlayerCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(8, this->has_announcement);
   buffer.encode_bool(9, this->announcement);
 }
+void MediaPlayerCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_command);
+  ProtoSize::add_enum<enums::MediaPlayerCommand>(total_size, 3, this->command);
+  ProtoSize::add_bool(total_size, 4, this->has_volume);
+  ProtoSize::add_float(total_size, 5, this->volume);
+  ProtoSize::add_bool(total_size, 6, this->has_media_url);
+  ProtoSize::add_string(total_size, 7, this->media_url);
+  ProtoSize::add_bool(total_size, 8, this->has_announcement);
+  ProtoSize::add_bool(total_size, 9, this->announcement);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void MediaPlayerCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5495,6 +6060,9 @@ bool SubscribeBluetoothLEAdvertisementsRequest::decode_varint(uint32_t field_id,
 void SubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->flags);
 }
+void SubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->flags);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5537,6 +6105,13 @@ void BluetoothServiceData::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_string(3, this->data);
 }
+void BluetoothServiceData::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->uuid);
+  for (auto &it : this->legacy_data) {
+    ProtoSize::add_uint32(total_size, 2, it, true);
+  }
+  ProtoSize::add_string(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothServiceData::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5613,6 +6188,21 @@ void BluetoothLEAdvertisementResponse::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_uint32(7, this->address_type);
 }
+void BluetoothLEAdvertisementResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_string(total_size, 2, this->name);
+  ProtoSize::add_sint32(total_size, 3, this->rssi);
+  for (auto &it : this->service_uuids) {
+    ProtoSize::add_string(total_size, 4, it, true);
+  }
+  for (auto &it : this->service_data) {
+    ProtoSize::add_message<BluetoothServiceData>(total_size, 5, it, true);
+  }
+  for (auto &it : this->manufacturer_data) {
+    ProtoSize::add_message<BluetoothServiceData>(total_size, 6, it, true);
+  }
+  ProtoSize::add_uint32(total_size, 7, this->address_type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLEAdvertisementResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5690,6 +6280,12 @@ void BluetoothLERawAdvertisement::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->address_type);
   buffer.encode_string(4, this->data);
 }
+void BluetoothLERawAdvertisement::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_sint32(total_size, 2, this->rssi);
+  ProtoSize::add_uint32(total_size, 3, this->address_type);
+  ProtoSize::add_string(total_size, 4, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLERawAdvertisement::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5730,6 +6326,11 @@ void BluetoothLERawAdvertisementsResponse::encode(ProtoWriteBuffer buffer) const
     buffer.encode_message<BluetoothLERawAdvertisement>(1, it, true);
   }
 }
+void BluetoothLERawAdvertisementsResponse::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->advertisements) {
+    ProtoSize::add_message<BluetoothLERawAdvertisement>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLERawAdvertisementsResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5770,6 +6371,12 @@ void BluetoothDeviceRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->has_address_type);
   buffer.encode_uint32(4, this->address_type);
 }
+void BluetoothDeviceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_enum<enums::BluetoothDeviceRequestType>(total_size, 2, this->request_type);
+  ProtoSize::add_bool(total_size, 3, this->has_address_type);
+  ProtoSize::add_uint32(total_size, 4, this->address_type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5822,6 +6429,12 @@ void BluetoothDeviceConnectionResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->mtu);
   buffer.encode_int32(4, this->error);
 }
+void BluetoothDeviceConnectionResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_bool(total_size, 2, this->connected);
+  ProtoSize::add_uint32(total_size, 3, this->mtu);
+  ProtoSize::add_int32(total_size, 4, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceConnectionResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5858,6 +6471,9 @@ bool BluetoothGATTGetServicesRequest::decode_varint(uint32_t field_id, ProtoVarI
   }
 }
 void BluetoothGATTGetServicesRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_uint64(1, this->address); }
+void BluetoothGATTGetServicesRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5889,6 +6505,12 @@ void BluetoothGATTDescriptor::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTDescriptor::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->uuid) {
+    ProtoSize::add_uint64(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTDescriptor::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5945,6 +6567,16 @@ void BluetoothGATTCharacteristic::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTDescriptor>(4, it, true);
   }
 }
+void BluetoothGATTCharacteristic::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->uuid) {
+    ProtoSize::add_uint64(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_uint32(total_size, 3, this->properties);
+  for (auto &it : this->descriptors) {
+    ProtoSize::add_message<BluetoothGATTDescriptor>(total_size, 4, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTCharacteristic::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6007,6 +6639,15 @@ void BluetoothGATTService::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTCharacteristic>(3, it, true);
   }
 }
+void BluetoothGATTService::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->uuid) {
+    ProtoSize::add_uint64(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  for (auto &it : this->characteristics) {
+    ProtoSize::add_message<BluetoothGATTCharacteristic>(total_size, 3, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTService::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6057,6 +6698,12 @@ void BluetoothGATTGetServicesResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTService>(2, it, true);
   }
 }
+void BluetoothGATTGetServicesResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  for (auto &it : this->services) {
+    ProtoSize::add_message<BluetoothGATTService>(total_size, 2, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6087,6 +6734,9 @@ bool BluetoothGATTGetServicesDoneResponse::decode_varint(uint32_t field_id, Prot
 void BluetoothGATTGetServicesDoneResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
 }
+void BluetoothGATTGetServicesDoneResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesDoneResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6116,6 +6766,10 @@ void BluetoothGATTReadRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTReadRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6161,6 +6815,11 @@ void BluetoothGATTReadResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTReadResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_string(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6202,7 +6861,7 @@ bool BluetoothGATTWriteRequest::decode_varint(uint32_t field_id, ProtoVarInt val
 bool BluetoothGATTWriteRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 4: {
-      this->data = value.as_string();
+      this->data = value.as_string_ref();
       return true;
     }
     default:
@@ -6215,6 +6874,12 @@ void BluetoothGATTWriteRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->response);
   buffer.encode_string(4, this->data);
 }
+void BluetoothGATTWriteRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_bool(total_size, 3, this->response);
+  ProtoSize::add_string(total_size, 4, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6234,7 +6899,7 @@ void BluetoothGATTWriteRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  data: ");
-  out.append("'").append(this->data).append("'");
+  out.append("'").append(this->data.c_str(), this->data.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -6257,6 +6922,10 @@ void BluetoothGATTReadDescriptorRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTReadDescriptorRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadDescriptorRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6290,7 +6959,7 @@ bool BluetoothGATTWriteDescriptorRequest::decode_varint(uint32_t field_id, Proto
 bool BluetoothGATTWriteDescriptorRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 3: {
-      this->data = value.as_string();
+      this->data = value.as_string_ref();
       return true;
     }
     default:
@@ -6302,6 +6971,11 @@ void BluetoothGATTWriteDescriptorRequest::encode(ProtoWriteBuffer buffer) const
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTWriteDescriptorRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_string(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteDescriptorRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6317,7 +6991,7 @@ void BluetoothGATTWriteDescriptorRequest::dump_to(std::string &out) const {
   out.append("\n");
 
   out.append("  data: ");
-  out.append("'").append(this->data).append("'");
+  out.append("'").append(this->data.c_str(), this->data.size()).append("'");
   out.append("\n");
   out.append("}");
 }
@@ -6345,6 +7019,11 @@ void BluetoothGATTNotifyRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_bool(3, this->enable);
 }
+void BluetoothGATTNotifyRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_bool(total_size, 3, this->enable);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6394,6 +7073,11 @@ void BluetoothGATTNotifyDataResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTNotifyDataResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_string(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyDataResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6415,6 +7099,7 @@ void BluetoothGATTNotifyDataResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeBluetoothConnectionsFreeRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeBluetoothConnectionsFreeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeBluetoothConnectionsFreeRequest::dump_to(std::string &out) const {
   out.append("SubscribeBluetoothConnectionsFreeRequest {}");
@@ -6438,6 +7123,10 @@ void BluetoothConnectionsFreeResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->free);
   buffer.encode_uint32(2, this->limit);
 }
+void BluetoothConnectionsFreeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->free);
+  ProtoSize::add_uint32(total_size, 2, this->limit);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothConnectionsFreeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6477,6 +7166,11 @@ void BluetoothGATTErrorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothGATTErrorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+  ProtoSize::add_int32(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTErrorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6516,6 +7210,10 @@ void BluetoothGATTWriteResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTWriteResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6550,6 +7248,10 @@ void BluetoothGATTNotifyResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTNotifyResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_uint32(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6589,6 +7291,11 @@ void BluetoothDevicePairingResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->paired);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDevicePairingResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_bool(total_size, 2, this->paired);
+  ProtoSize::add_int32(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDevicePairingResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6632,6 +7339,11 @@ void BluetoothDeviceUnpairingResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDeviceUnpairingResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_bool(total_size, 2, this->success);
+  ProtoSize::add_int32(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceUnpairingResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6653,6 +7365,7 @@ void BluetoothDeviceUnpairingResponse::dump_to(std::string &out) const {
 }
 #endif
 void UnsubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {}
+void UnsubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void UnsubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
   out.append("UnsubscribeBluetoothLEAdvertisementsRequest {}");
@@ -6681,6 +7394,11 @@ void BluetoothDeviceClearCacheResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDeviceClearCacheResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64(total_size, 1, this->address);
+  ProtoSize::add_bool(total_size, 2, this->success);
+  ProtoSize::add_int32(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceClearCacheResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6719,6 +7437,10 @@ void SubscribeVoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(1, this->subscribe);
   buffer.encode_uint32(2, this->flags);
 }
+void SubscribeVoiceAssistantRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->subscribe);
+  ProtoSize::add_uint32(total_size, 2, this->flags);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeVoiceAssistantRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6763,6 +7485,11 @@ void VoiceAssistantAudioSettings::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->auto_gain);
   buffer.encode_float(3, this->volume_multiplier);
 }
+void VoiceAssistantAudioSettings::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->noise_suppression_level);
+  ProtoSize::add_uint32(total_size, 2, this->auto_gain);
+  ProtoSize::add_float(total_size, 3, this->volume_multiplier);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantAudioSettings::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6823,6 +7550,13 @@ void VoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_message<VoiceAssistantAudioSettings>(4, this->audio_settings);
   buffer.encode_string(5, this->wake_word_phrase);
 }
+void VoiceAssistantRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->start);
+  ProtoSize::add_string(total_size, 2, this->conversation_id);
+  ProtoSize::add_uint32(total_size, 3, this->flags);
+  ProtoSize::add_message<VoiceAssistantAudioSettings>(total_size, 4, this->audio_settings);
+  ProtoSize::add_string(total_size, 5, this->wake_word_phrase);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6868,6 +7602,10 @@ void VoiceAssistantResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->port);
   buffer.encode_bool(2, this->error);
 }
+void VoiceAssistantResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->port);
+  ProtoSize::add_bool(total_size, 2, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6901,6 +7639,10 @@ void VoiceAssistantEventData::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_string(2, this->value);
 }
+void VoiceAssistantEventData::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->name);
+  ProtoSize::add_string(total_size, 2, this->value);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantEventData::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6941,6 +7683,12 @@ void VoiceAssistantEventResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<VoiceAssistantEventData>(2, it, true);
   }
 }
+void VoiceAssistantEventResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum<enums::VoiceAssistantEvent>(total_size, 1, this->event_type);
+  for (auto &it : this->data) {
+    ProtoSize::add_message<VoiceAssistantEventData>(total_size, 2, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantEventResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6970,7 +7718,7 @@ bool VoiceAssistantAudio::decode_varint(uint32_t field_id, ProtoVarInt value) {
 bool VoiceAssistantAudio::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
   switch (field_id) {
     case 1: {
-      this->data = value.as_string();
+      this->data = value.as_string_ref();
       return true;
     }
     default:
@@ -6981,12 +7729,16 @@ void VoiceAssistantAudio::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->data);
   buffer.encode_bool(2, this->end);
 }
+void VoiceAssistantAudio::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->data);
+  ProtoSize::add_bool(total_size, 2, this->end);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantAudio::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
   out.append("VoiceAssistantAudio {\n");
   out.append("  data: ");
-  out.append("'").append(this->data).append("'");
+  out.append("'").append(this->data.c_str(), this->data.size()).append("'");
   out.append("\n");
 
   out.append("  end: ");
@@ -7039,6 +7791,14 @@ void VoiceAssistantTimerEventResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(5, this->seconds_left);
   buffer.encode_bool(6, this->is_active);
 }
+void VoiceAssistantTimerEventResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum<enums::VoiceAssistantTimerEvent>(total_size, 1, this->event_type);
+  ProtoSize::add_string(total_size, 2, this->timer_id);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_uint32(total_size, 4, this->total_seconds);
+  ProtoSize::add_uint32(total_size, 5, this->seconds_left);
+  ProtoSize::add_bool(total_size, 6, this->is_active);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantTimerEventResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7089,6 +7849,10 @@ void VoiceAssistantAnnounceRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->media_id);
   buffer.encode_string(2, this->text);
 }
+void VoiceAssistantAnnounceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->media_id);
+  ProtoSize::add_string(total_size, 2, this->text);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantAnnounceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7114,6 +7878,9 @@ bool VoiceAssistantAnnounceFinished::decode_varint(uint32_t field_id, ProtoVarIn
   }
 }
 void VoiceAssistantAnnounceFinished::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->success); }
+void VoiceAssistantAnnounceFinished::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool(total_size, 1, this->success);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantAnnounceFinished::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7149,6 +7916,13 @@ void VoiceAssistantWakeWord::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(3, it, true);
   }
 }
+void VoiceAssistantWakeWord::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->id);
+  ProtoSize::add_string(total_size, 2, this->wake_word);
+  for (auto &it : this->trained_languages) {
+    ProtoSize::add_string(total_size, 3, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantWakeWord::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7170,6 +7944,7 @@ void VoiceAssistantWakeWord::dump_to(std::string &out) const {
 }
 #endif
 void VoiceAssistantConfigurationRequest::encode(ProtoWriteBuffer buffer) const {}
+void VoiceAssistantConfigurationRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantConfigurationRequest::dump_to(std::string &out) const {
   out.append("VoiceAssistantConfigurationRequest {}");
@@ -7208,6 +7983,15 @@ void VoiceAssistantConfigurationResponse::encode(ProtoWriteBuffer buffer) const
   }
   buffer.encode_uint32(3, this->max_active_wake_words);
 }
+void VoiceAssistantConfigurationResponse::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->available_wake_words) {
+    ProtoSize::add_message<VoiceAssistantWakeWord>(total_size, 1, it, true);
+  }
+  for (auto &it : this->active_wake_words) {
+    ProtoSize::add_string(total_size, 2, it, true);
+  }
+  ProtoSize::add_uint32(total_size, 3, this->max_active_wake_words);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantConfigurationResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7246,6 +8030,11 @@ void VoiceAssistantSetConfiguration::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(1, it, true);
   }
 }
+void VoiceAssistantSetConfiguration::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->active_wake_words) {
+    ProtoSize::add_string(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantSetConfiguration::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7328,6 +8117,18 @@ void ListEntitiesAlarmControlPanelResponse::encode(ProtoWriteBuffer buffer) cons
   buffer.encode_bool(9, this->requires_code);
   buffer.encode_bool(10, this->requires_code_to_arm);
 }
+void ListEntitiesAlarmControlPanelResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_uint32(total_size, 8, this->supported_features);
+  ProtoSize::add_bool(total_size, 9, this->requires_code);
+  ProtoSize::add_bool(total_size, 10, this->requires_code_to_arm);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesAlarmControlPanelResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7400,6 +8201,10 @@ void AlarmControlPanelStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::AlarmControlPanelState>(2, this->state);
 }
+void AlarmControlPanelStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::AlarmControlPanelState>(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void AlarmControlPanelStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7450,6 +8255,11 @@ void AlarmControlPanelCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::AlarmControlPanelStateCommand>(2, this->command);
   buffer.encode_string(3, this->code);
 }
+void AlarmControlPanelCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::AlarmControlPanelStateCommand>(total_size, 2, this->command);
+  ProtoSize::add_string(total_size, 3, this->code);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void AlarmControlPanelCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7544,6 +8354,19 @@ void ListEntitiesTextResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(10, this->pattern);
   buffer.encode_enum<enums::TextMode>(11, this->mode);
 }
+void ListEntitiesTextResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_uint32(total_size, 8, this->min_length);
+  ProtoSize::add_uint32(total_size, 9, this->max_length);
+  ProtoSize::add_string(total_size, 10, this->pattern);
+  ProtoSize::add_enum<enums::TextMode>(total_size, 11, this->mode);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesTextResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7632,6 +8455,11 @@ void TextStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void TextStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+  ProtoSize::add_bool(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7675,6 +8503,10 @@ void TextCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
 }
+void TextCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7745,6 +8577,15 @@ void ListEntitiesDateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesDateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesDateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7819,6 +8660,13 @@ void DateStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(4, this->month);
   buffer.encode_uint32(5, this->day);
 }
+void DateStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->missing_state);
+  ProtoSize::add_uint32(total_size, 3, this->year);
+  ProtoSize::add_uint32(total_size, 4, this->month);
+  ProtoSize::add_uint32(total_size, 5, this->day);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DateStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7883,6 +8731,12 @@ void DateCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->month);
   buffer.encode_uint32(4, this->day);
 }
+void DateCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_uint32(total_size, 2, this->year);
+  ProtoSize::add_uint32(total_size, 3, this->month);
+  ProtoSize::add_uint32(total_size, 4, this->day);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DateCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7964,6 +8818,15 @@ void ListEntitiesTimeResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesTimeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesTimeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8038,6 +8901,13 @@ void TimeStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(4, this->minute);
   buffer.encode_uint32(5, this->second);
 }
+void TimeStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->missing_state);
+  ProtoSize::add_uint32(total_size, 3, this->hour);
+  ProtoSize::add_uint32(total_size, 4, this->minute);
+  ProtoSize::add_uint32(total_size, 5, this->second);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TimeStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8102,6 +8972,12 @@ void TimeCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->minute);
   buffer.encode_uint32(4, this->second);
 }
+void TimeCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_uint32(total_size, 2, this->hour);
+  ProtoSize::add_uint32(total_size, 3, this->minute);
+  ProtoSize::add_uint32(total_size, 4, this->second);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TimeCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8195,6 +9071,19 @@ void ListEntitiesEventResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(9, it, true);
   }
 }
+void ListEntitiesEventResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_string(total_size, 8, this->device_class);
+  for (auto &it : this->event_types) {
+    ProtoSize::add_string(total_size, 9, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesEventResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8264,6 +9153,10 @@ void EventResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->event_type);
 }
+void EventResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_string(total_size, 2, this->event_type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void EventResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8354,6 +9247,19 @@ void ListEntitiesValveResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(10, this->supports_position);
   buffer.encode_bool(11, this->supports_stop);
 }
+void ListEntitiesValveResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_string(total_size, 8, this->device_class);
+  ProtoSize::add_bool(total_size, 9, this->assumed_state);
+  ProtoSize::add_bool(total_size, 10, this->supports_position);
+  ProtoSize::add_bool(total_size, 11, this->supports_stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesValveResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8434,6 +9340,11 @@ void ValveStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->position);
   buffer.encode_enum<enums::ValveOperation>(3, this->current_operation);
 }
+void ValveStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_float(total_size, 2, this->position);
+  ProtoSize::add_enum<enums::ValveOperation>(total_size, 3, this->current_operation);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ValveStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8488,6 +9399,12 @@ void ValveCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(3, this->position);
   buffer.encode_bool(4, this->stop);
 }
+void ValveCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->has_position);
+  ProtoSize::add_float(total_size, 3, this->position);
+  ProtoSize::add_bool(total_size, 4, this->stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ValveCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8567,6 +9484,15 @@ void ListEntitiesDateTimeResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesDateTimeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesDateTimeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8631,6 +9557,11 @@ void DateTimeStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->missing_state);
   buffer.encode_fixed32(3, this->epoch_seconds);
 }
+void DateTimeStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->missing_state);
+  ProtoSize::add_fixed32(total_size, 3, this->epoch_seconds);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DateTimeStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8669,6 +9600,10 @@ void DateTimeCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_fixed32(2, this->epoch_seconds);
 }
+void DateTimeCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_fixed32(total_size, 2, this->epoch_seconds);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DateTimeCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8745,6 +9680,16 @@ void ListEntitiesUpdateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_string(8, this->device_class);
 }
+void ListEntitiesUpdateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32(total_size, 2, this->key);
+  ProtoSize::add_string(total_size, 3, this->name);
+  ProtoSize::add_string(total_size, 4, this->unique_id);
+  ProtoSize::add_string(total_size, 5, this->icon);
+  ProtoSize::add_bool(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_string(total_size, 8, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesUpdateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8854,6 +9799,18 @@ void UpdateStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(9, this->release_summary);
   buffer.encode_string(10, this->release_url);
 }
+void UpdateStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_bool(total_size, 2, this->missing_state);
+  ProtoSize::add_bool(total_size, 3, this->in_progress);
+  ProtoSize::add_bool(total_size, 4, this->has_progress);
+  ProtoSize::add_float(total_size, 5, this->progress);
+  ProtoSize::add_string(total_size, 6, this->current_version);
+  ProtoSize::add_string(total_size, 7, this->latest_version);
+  ProtoSize::add_string(total_size, 8, this->title);
+  ProtoSize::add_string(total_size, 9, this->release_summary);
+  ProtoSize::add_string(total_size, 10, this->release_url);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void UpdateStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8926,6 +9883,10 @@ void UpdateCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::UpdateCommand>(2, this->command);
 }
+void UpdateCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32(total_size, 1, this->key);
+  ProtoSize::add_enum<enums::UpdateCommand>(total_size, 2, this->command);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void UpdateCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -8941,6 +9902,228 @@ void UpdateCommandRequest::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
+void ComponentTimingsRequest::encode(ProtoWriteBuffer buffer) const {}
+void ComponentTimingsRequest::calculate_size(uint32_t &total_size) const {}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ComponentTimingsRequest::dump_to(std::string &out) const { out.append("ComponentTimingsRequest {}"); }
+#endif
+bool ComponentTiming::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 2: {
+      this->loop_histogram.push_back(value.as_uint32());
+      return true;
+    }
+    case 3: {
+      this->loop_total_us = value.as_uint64();
+      return true;
+    }
+    case 4: {
+      this->loop_max_us = value.as_uint32();
+      return true;
+    }
+    case 5: {
+      this->scheduler_histogram.push_back(value.as_uint32());
+      return true;
+    }
+    case 6: {
+      this->scheduler_total_us = value.as_uint64();
+      return true;
+    }
+    case 7: {
+      this->scheduler_max_us = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool ComponentTiming::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->source = value.as_string();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ComponentTiming::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_string(1, this->source);
+  for (auto &it : this->loop_histogram) {
+    buffer.encode_uint32(2, it, true);
+  }
+  buffer.encode_uint64(3, this->loop_total_us);
+  buffer.encode_uint32(4, this->loop_max_us);
+  for (auto &it : this->scheduler_histogram) {
+    buffer.encode_uint32(5, it, true);
+  }
+  buffer.encode_uint64(6, this->scheduler_total_us);
+  buffer.encode_uint32(7, this->scheduler_max_us);
+}
+void ComponentTiming::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string(total_size, 1, this->source);
+  for (auto &it : this->loop_histogram) {
+    ProtoSize::add_uint32(total_size, 2, it, true);
+  }
+  ProtoSize::add_uint64(total_size, 3, this->loop_total_us);
+  ProtoSize::add_uint32(total_size, 4, this->loop_max_us);
+  for (auto &it : this->scheduler_histogram) {
+    ProtoSize::add_uint32(total_size, 5, it, true);
+  }
+  ProtoSize::add_uint64(total_size, 6, this->scheduler_total_us);
+  ProtoSize::add_uint32(total_size, 7, this->scheduler_max_us);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ComponentTiming::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ComponentTiming {\n");
+  out.append("  source: ");
+  out.append("'").append(this->source).append("'");
+  out.append("\n");
+
+  for (const auto &it : this->loop_histogram) {
+    out.append("  loop_histogram: ");
+    sprintf(buffer, "%" PRIu32, it);
+    out.append(buffer);
+    out.append("\n");
+  }
+
+  out.append("  loop_total_us: ");
+  sprintf(buffer, "%llu", this->loop_total_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  loop_max_us: ");
+  sprintf(buffer, "%" PRIu32, this->loop_max_us);
+  out.append(buffer);
+  out.append("\n");
+
+  for (const auto &it : this->scheduler_histogram) {
+    out.append("  scheduler_histogram: ");
+    sprintf(buffer, "%" PRIu32, it);
+    out.append(buffer);
+    out.append("\n");
+  }
+
+  out.append("  scheduler_total_us: ");
+  sprintf(buffer, "%llu", this->scheduler_total_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  scheduler_max_us: ");
+  sprintf(buffer, "%" PRIu32, this->scheduler_max_us);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool ComponentTimingsResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->components.push_back(value.as_message<ComponentTiming>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void ComponentTimingsResponse::encode(ProtoWriteBuffer buffer) const {
+  for (auto &it : this->components) {
+    buffer.encode_message<ComponentTiming>(1, it, true);
+  }
+}
+void ComponentTimingsResponse::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->components) {
+    ProtoSize::add_message<ComponentTiming>(total_size, 1, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void ComponentTimingsResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("ComponentTimingsResponse {\n");
+  for (const auto &it : this->components) {
+    out.append("  components: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
+bool BatchedMessage::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->type = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool BatchedMessage::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 2: {
+      this->data = value.as_string();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void BatchedMessage::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_uint32(1, this->type);
+  buffer.encode_string(2, this->data);
+}
+void BatchedMessage::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32(total_size, 1, this->type);
+  ProtoSize::add_string(total_size, 2, this->data);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void BatchedMessage::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("BatchedMessage {\n");
+  out.append("  type: ");
+  sprintf(buffer, "%" PRIu32, this->type);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  data: ");
+  out.append("'").append(this->data).append("'");
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool BatchedMessagesResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->messages.push_back(value.as_message<BatchedMessage>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void BatchedMessagesResponse::encode(ProtoWriteBuffer buffer) const {
+  for (auto &it : this->messages) {
+    buffer.encode_message<BatchedMessage>(1, it, true);
+  }
+}
+void BatchedMessagesResponse::calculate_size(uint32_t &total_size) const {
+  for (auto &it : this->messages) {
+    ProtoSize::add_message<BatchedMessage>(total_size, 1, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void BatchedMessagesResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("BatchedMessagesResponse {\n");
+  for (const auto &it : this->messages) {
+    out.append("  messages: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
@@ -652,6 +652,22 @@ bool APIServerConnectionBase::send_update_state_response(const UpdateStateRespon
 #endif
 #ifdef USE_UPDATE
 #endif
+#ifdef USE_LOOP_PROFILER
+#endif
+#ifdef USE_LOOP_PROFILER
+bool APIServerConnectionBase::send_component_timings_response(const ComponentTimingsResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_component_timings_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<ComponentTimingsResponse>(msg, 125);
+}
+#endif
+bool APIServerConnectionBase::send_batched_messages_response(const BatchedMessagesResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_batched_messages_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<BatchedMessagesResponse>(msg, 126);
+}
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -1191,6 +1207,17 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       ESP_LOGVV(TAG, "on_voice_assistant_set_configuration: %s", msg.dump().c_str());
 #endif
       this->on_voice_assistant_set_configuration(msg);
+#endif
+      break;
+    }
+    case 124: {
+#ifdef USE_LOOP_PROFILER
+      ComponentTimingsRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_component_timings_request: %s", msg.dump().c_str());
+#endif
+      this->on_component_timings_request(msg);
 #endif
       break;
     }
@@ -1723,6 +1750,22 @@ void APIServerConnection::on_alarm_control_panel_command_request(const AlarmCont
   this->alarm_control_panel_command(msg);
 }
 #endif
+#ifdef USE_LOOP_PROFILER
+void APIServerConnection::on_component_timings_request(const ComponentTimingsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  ComponentTimingsResponse ret = this->get_component_timings(msg);
+  if (!this->send_component_timings_response(ret)) {
+    this->on_fatal_error();
+  }
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
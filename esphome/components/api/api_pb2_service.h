@@ -331,6 +331,13 @@ class APIServerConnectionBase : public ProtoService {
 #ifdef USE_UPDATE
   virtual void on_update_command_request(const UpdateCommandRequest &value){};
 #endif
+#ifdef USE_LOOP_PROFILER
+  virtual void on_component_timings_request(const ComponentTimingsRequest &value){};
+#endif
+#ifdef USE_LOOP_PROFILER
+  bool send_component_timings_response(const ComponentTimingsResponse &msg);
+#endif
+  bool send_batched_messages_response(const BatchedMessagesResponse &msg);
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
 };
@@ -443,6 +450,9 @@ class APIServerConnection : public APIServerConnectionBase {
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   virtual void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) = 0;
+#endif
+#ifdef USE_LOOP_PROFILER
+  virtual ComponentTimingsResponse get_component_timings(const ComponentTimingsRequest &msg) = 0;
 #endif
  protected:
   void on_hello_request(const HelloRequest &msg) override;
@@ -551,6 +561,9 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_ALARM_CONTROL_PANEL
   void on_alarm_control_panel_command_request(const AlarmControlPanelCommandRequest &msg) override;
 #endif
+#ifdef USE_LOOP_PROFILER
+  void on_component_timings_request(const ComponentTimingsRequest &msg) override;
+#endif
 };
 
 }  // namespace api
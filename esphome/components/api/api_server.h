@@ -26,6 +26,10 @@ class APIServer : public Component, public Controller {
   uint16_t get_port() const;
   float get_setup_priority() const override;
   void loop() override;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// Incoming data and new clients wake the loop through their sockets, so only in-flight work needs polling.
+  bool needs_polling() const override;
+#endif
   void dump_config() override;
   void on_shutdown() override;
   bool check_password(const std::string &password) const;
@@ -33,6 +37,9 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /// Collect state updates for up to this many milliseconds and send them in one frame, 0 disables batching.
+  void set_batch_delay(uint32_t batch_delay) { this->batch_delay_ = batch_delay; }
+  uint32_t get_batch_delay() const { return this->batch_delay_; }
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -132,6 +139,7 @@ class APIServer : public Component, public Controller {
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  uint32_t batch_delay_{0};
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
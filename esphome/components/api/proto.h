@@ -3,7 +3,9 @@
 #include "esphome/core/component.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/string_ref.h"
 
+#include <cstring>
 #include <vector>
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
@@ -96,6 +98,8 @@ class ProtoLengthDelimited {
  public:
   explicit ProtoLengthDelimited(const uint8_t *value, size_t length) : value_(value), length_(length) {}
   std::string as_string() const { return std::string(reinterpret_cast<const char *>(this->value_), this->length_); }
+  /// View of the value without copying it, only valid as long as the received packet is.
+  StringRef as_string_ref() const { return StringRef(this->value_, this->length_); }
   template<class C> C as_message() const {
     auto msg = C();
     msg.decode(this->value_, this->length_);
@@ -143,11 +147,26 @@ class Proto64Bit {
   const uint64_t value_;
 };
 
+/** Writes an encoded message into a buffer that was sized with ProtoSize beforehand.
+ *
+ * The buffer is usually the space between the frame header and footer inside the frame that is sent out, so
+ * nothing needs to be copied or moved after encoding. Writes past the end are dropped.
+ */
 class ProtoWriteBuffer {
  public:
-  ProtoWriteBuffer(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
-  void write(uint8_t value) { this->buffer_->push_back(value); }
-  void encode_varint_raw(ProtoVarInt value) { value.encode(*this->buffer_); }
+  ProtoWriteBuffer(uint8_t *data, size_t size) : data_(data), pos_(data), end_(data + size) {}
+  void write(uint8_t value) {
+    if (this->pos_ < this->end_)
+      *this->pos_++ = value;
+  }
+  void encode_varint_raw(ProtoVarInt value) {
+    uint64_t val = value.as_uint64();
+    while (val > 0x7F) {
+      this->write((val & 0x7F) | 0x80);
+      val >>= 7;
+    }
+    this->write(val);
+  }
   void encode_varint_raw(uint32_t value) { this->encode_varint_raw(ProtoVarInt(value)); }
   void encode_field_raw(uint32_t field_id, uint32_t type) {
     uint32_t val = (field_id << 3) | (type & 0b111);
@@ -159,12 +178,16 @@ class ProtoWriteBuffer {
 
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
-    auto *data = reinterpret_cast<const uint8_t *>(string);
-    this->buffer_->insert(this->buffer_->end(), data, data + len);
+    len = std::min(len, static_cast<size_t>(this->end_ - this->pos_));
+    memcpy(this->pos_, string, len);
+    this->pos_ += len;
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
     this->encode_string(field_id, value.data(), value.size());
   }
+  void encode_string(uint32_t field_id, const StringRef &value, bool force = false) {
+    this->encode_string(field_id, value.c_str(), value.size(), force);
+  }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
   }
@@ -254,27 +277,147 @@ class ProtoWriteBuffer {
     this->encode_uint64(field_id, uvalue, force);
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
+    this->encode_varint_raw(nested_length);
+    if (nested_length > static_cast<size_t>(this->end_ - this->pos_)) {
+      this->pos_ = this->end_;
+      return;
+    }
+    // encode() takes the buffer by value, so step over the nested message here
+    value.encode(ProtoWriteBuffer(this->pos_, nested_length));
+    this->pos_ += nested_length;
+  }
+  uint8_t *get_data() const { return this->data_; }
+  size_t get_size() const { return this->end_ - this->data_; }
 
-    value.encode(*this);
+ protected:
+  uint8_t *data_;
+  uint8_t *pos_;
+  uint8_t *end_;
+};
 
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
+/// Computes encoded message sizes, each method mirrors the ProtoWriteBuffer encode method of the same type.
+class ProtoSize {
+ public:
+  static uint32_t varint(uint32_t value) {
+    if (value < (1 << 7))
+      return 1;
+    if (value < (1 << 14))
+      return 2;
+    if (value < (1 << 21))
+      return 3;
+    if (value < (1 << 28))
+      return 4;
+    return 5;
+  }
+  static uint32_t varint(uint64_t value) {
+    uint32_t size = 1;
+    while (value > 0x7F) {
+      value >>= 7;
+      size++;
+    }
+    return size;
   }
-  std::vector<uint8_t> *get_buffer() const { return buffer_; }
+  static uint32_t field(uint32_t field_id, uint32_t type) { return varint((field_id << 3) | (type & 0b111)); }
 
- protected:
-  std::vector<uint8_t> *buffer_;
+  static void add_string(uint32_t &total_size, uint32_t field_id, size_t len, bool force = false) {
+    if (len == 0 && !force)
+      return;
+    total_size += field(field_id, 2) + varint(static_cast<uint32_t>(len)) + len;
+  }
+  static void add_string(uint32_t &total_size, uint32_t field_id, const std::string &value, bool force = false) {
+    add_string(total_size, field_id, value.size());
+  }
+  static void add_string(uint32_t &total_size, uint32_t field_id, const StringRef &value, bool force = false) {
+    add_string(total_size, field_id, value.size(), force);
+  }
+  static void add_bytes(uint32_t &total_size, uint32_t field_id, size_t len, bool force = false) {
+    add_string(total_size, field_id, len, force);
+  }
+  static void add_uint32(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_uint64(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_bool(uint32_t &total_size, uint32_t field_id, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field(field_id, 0) + 1;
+  }
+  static void add_fixed32(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_fixed64(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 8;
+  }
+  template<typename T> static void add_enum(uint32_t &total_size, uint32_t field_id, T value, bool force = false) {
+    add_uint32(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_float(uint32_t &total_size, uint32_t field_id, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+
+    union {
+      float value;
+      uint32_t raw;
+    } val{};
+    val.value = value;
+    add_fixed32(total_size, field_id, val.raw);
+  }
+  static void add_int32(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      add_int64(total_size, field_id, value, force);
+      return;
+    }
+    add_uint32(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_int64(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_uint64(total_size, field_id, static_cast<uint64_t>(value), force);
+  }
+  static void add_sint32(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    uint32_t uvalue;
+    if (value < 0) {
+      uvalue = ~(value << 1);
+    } else {
+      uvalue = value << 1;
+    }
+    add_uint32(total_size, field_id, uvalue, force);
+  }
+  static void add_sint64(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    uint64_t uvalue;
+    if (value < 0) {
+      uvalue = ~(value << 1);
+    } else {
+      uvalue = value << 1;
+    }
+    add_uint64(total_size, field_id, uvalue, force);
+  }
+  template<class C>
+  static void add_message(uint32_t &total_size, uint32_t field_id, const C &value, bool force = false) {
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    total_size += field(field_id, 2) + varint(nested_length) + nested_length;
+  }
 };
 
 class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the number of bytes encode() will write to total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -298,12 +441,15 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  /// Get a buffer for a message payload of exactly the given size.
+  virtual ProtoWriteBuffer create_buffer(uint32_t size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    auto buffer = this->create_buffer(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
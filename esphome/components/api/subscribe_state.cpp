@@ -8,7 +8,7 @@ namespace api {
 
 #ifdef USE_BINARY_SENSOR
 bool InitialStateIterator::on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
-  return this->client_->send_binary_sensor_state(binary_sensor, binary_sensor->state);
+  return this->client_->send_binary_sensor_state(binary_sensor);
 }
 #endif
 #ifdef USE_COVER
@@ -22,17 +22,17 @@ bool InitialStateIterator::on_light(light::LightState *light) { return this->cli
 #endif
 #ifdef USE_SENSOR
 bool InitialStateIterator::on_sensor(sensor::Sensor *sensor) {
-  return this->client_->send_sensor_state(sensor, sensor->state);
+  return this->client_->send_sensor_state(sensor);
 }
 #endif
 #ifdef USE_SWITCH
 bool InitialStateIterator::on_switch(switch_::Switch *a_switch) {
-  return this->client_->send_switch_state(a_switch, a_switch->state);
+  return this->client_->send_switch_state(a_switch);
 }
 #endif
 #ifdef USE_TEXT_SENSOR
 bool InitialStateIterator::on_text_sensor(text_sensor::TextSensor *text_sensor) {
-  return this->client_->send_text_sensor_state(text_sensor, text_sensor->state);
+  return this->client_->send_text_sensor_state(text_sensor);
 }
 #endif
 #ifdef USE_CLIMATE
@@ -40,7 +40,7 @@ bool InitialStateIterator::on_climate(climate::Climate *climate) { return this->
 #endif
 #ifdef USE_NUMBER
 bool InitialStateIterator::on_number(number::Number *number) {
-  return this->client_->send_number_state(number, number->state);
+  return this->client_->send_number_state(number);
 }
 #endif
 #ifdef USE_DATETIME_DATE
@@ -55,15 +55,15 @@ bool InitialStateIterator::on_datetime(datetime::DateTimeEntity *datetime) {
 }
 #endif
 #ifdef USE_TEXT
-bool InitialStateIterator::on_text(text::Text *text) { return this->client_->send_text_state(text, text->state); }
+bool InitialStateIterator::on_text(text::Text *text) { return this->client_->send_text_state(text); }
 #endif
 #ifdef USE_SELECT
 bool InitialStateIterator::on_select(select::Select *select) {
-  return this->client_->send_select_state(select, select->state);
+  return this->client_->send_select_state(select);
 }
 #endif
 #ifdef USE_LOCK
-bool InitialStateIterator::on_lock(lock::Lock *a_lock) { return this->client_->send_lock_state(a_lock, a_lock->state); }
+bool InitialStateIterator::on_lock(lock::Lock *a_lock) { return this->client_->send_lock_state(a_lock); }
 #endif
 #ifdef USE_VALVE
 bool InitialStateIterator::on_valve(valve::Valve *valve) { return this->client_->send_valve_state(valve); }
@@ -0,0 +1,19 @@
+#include "audio_dsp.h"
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace audio {
+
+void DCOffsetRemover::process(int16_t *samples, size_t count) {
+  int32_t offset = this->offset_;
+  for (size_t i = 0; i < count; i++) {
+    int32_t sample = samples[i];
+    offset += ((sample * 4096) - offset) >> 10;
+    samples[i] = clamp<int32_t>(sample - ((offset + 2048) >> 12), INT16_MIN, INT16_MAX);
+  }
+  this->offset_ = offset;
+}
+
+}  // namespace audio
+}  // namespace esphome
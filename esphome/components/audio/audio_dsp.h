@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace audio {
+
+/** Removes the DC offset of a continuous stream of samples.
+ *
+ * Microphones often add a constant offset to their samples, which wastes headroom and upsets level based processing.
+ * The offset is tracked with a slow moving average (a time constant of 1024 samples, about 2.5 Hz at 16 kHz) and
+ * subtracted from every sample.
+ */
+class DCOffsetRemover {
+ public:
+  /// Removes the offset from samples in place.
+  void process(int16_t *samples, size_t count);
+  /// Forget the tracked offset, for example when a new stream starts.
+  void reset() { this->offset_ = 0; }
+
+ protected:
+  /// The offset with 12 bits after the point.
+  int32_t offset_{0};
+};
+
+}  // namespace audio
+}  // namespace esphome
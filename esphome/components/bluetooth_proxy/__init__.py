@@ -10,6 +10,8 @@ CODEOWNERS = ["@jesserockz"]
 
 CONF_CACHE_SERVICES = "cache_services"
 CONF_CONNECTIONS = "connections"
+CONF_DUPLICATE_WINDOW = "duplicate_window"
+CONF_MIN_INTERVAL = "min_interval"
 MAX_CONNECTIONS = 3
 
 bluetooth_proxy_ns = cg.esphome_ns.namespace("bluetooth_proxy")
@@ -56,6 +58,10 @@ CONFIG_SCHEMA = cv.All(
                 cv.ensure_list(CONNECTION_SCHEMA),
                 cv.Length(min=1, max=MAX_CONNECTIONS),
             ),
+            cv.Optional(
+                CONF_DUPLICATE_WINDOW
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_MIN_INTERVAL): cv.positive_time_period_milliseconds,
         }
     )
     .extend(esp32_ble_tracker.ESP_BLE_DEVICE_SCHEMA)
@@ -69,6 +75,10 @@ async def to_code(config):
     await cg.register_component(var, config)
 
     cg.add(var.set_active(config[CONF_ACTIVE]))
+    if duplicate_window := config.get(CONF_DUPLICATE_WINDOW):
+        cg.add(var.set_duplicate_window(duplicate_window))
+    if min_interval := config.get(CONF_MIN_INTERVAL):
+        cg.add(var.set_min_interval(min_interval))
     await esp32_ble_tracker.register_ble_device(var, config)
 
     for connection_conf in config.get(CONF_CONNECTIONS, []):
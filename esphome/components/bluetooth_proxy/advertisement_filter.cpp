@@ -0,0 +1,66 @@
+#include "advertisement_filter.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace bluetooth_proxy {
+
+bool AdvertisementFilter::should_forward(uint64_t address, bool scan_response, const uint8_t *data, size_t length,
+                                         uint32_t now) {
+  if (!this->is_enabled()) {
+    this->forwarded_++;
+    return true;
+  }
+  if (this->entries_.empty())
+    this->entries_.resize(CAPACITY, Entry{0, 0, 0});
+
+  // FNV-1a
+  uint32_t data_hash = 2166136261UL;
+  for (size_t i = 0; i < length; i++) {
+    data_hash ^= data[i];
+    data_hash *= 16777619UL;
+  }
+
+  const uint64_t key = address | USED | (scan_response ? SCAN_RESPONSE : 0);
+  const uint32_t hold = std::max(this->duplicate_window_, this->min_interval_);
+  const size_t home = (key * 0x9E3779B97F4A7C15ULL) >> 56;
+  Entry *slot = nullptr;
+  Entry *oldest = nullptr;
+  // Slots are only ever reused, never emptied, so a device can't be stored behind an unused slot
+  for (size_t i = 0; i < MAX_PROBE; i++) {
+    Entry &entry = this->entries_[(home + i) & (CAPACITY - 1)];
+    if (entry.key == key) {
+      const uint32_t age = now - entry.last_forwarded;
+      if (age < this->min_interval_) {
+        this->rate_limited_++;
+        return false;
+      }
+      if (entry.data_hash == data_hash && age < this->duplicate_window_) {
+        this->duplicates_++;
+        return false;
+      }
+      entry.data_hash = data_hash;
+      entry.last_forwarded = now;
+      this->forwarded_++;
+      return true;
+    }
+    if (entry.key == 0) {
+      if (slot == nullptr)
+        slot = &entry;
+      break;
+    }
+    if (slot == nullptr && now - entry.last_forwarded >= hold)
+      slot = &entry;
+    if (oldest == nullptr || now - entry.last_forwarded > now - oldest->last_forwarded)
+      oldest = &entry;
+  }
+
+  if (slot == nullptr)
+    slot = oldest;
+  *slot = Entry{key, data_hash, now};
+  this->forwarded_++;
+  return true;
+}
+
+}  // namespace bluetooth_proxy
+}  // namespace esphome
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace bluetooth_proxy {
+
+/** Decides which raw advertisements are worth forwarding to the API client.
+ *
+ * Most BLE devices repeat the same advertisement many times per second. The filter remembers the last forwarded
+ * payload of each device in a small open addressing hash table, and suppresses
+ *  - advertisements whose payload did not change within the duplicate window, and
+ *  - any advertisement of a device that was already forwarded within the minimum interval.
+ *
+ * Advertisements and scan responses are tracked separately, keyed by MAC address and packet type. With active
+ * scanning a device alternates between the two, so a single entry per device would never see a repeated payload
+ * and would rate limit every scan response away.
+ *
+ * The table has a fixed size. When a probe sequence is full, the device that was forwarded longest ago is forgotten,
+ * which at worst lets one of its advertisements through early.
+ */
+class AdvertisementFilter {
+ public:
+  /// Suppress unchanged advertisements of a device for this many milliseconds after it was last forwarded.
+  void set_duplicate_window(uint32_t duplicate_window) { this->duplicate_window_ = duplicate_window; }
+  /// Forward at most one advertisement of a device per this many milliseconds.
+  void set_min_interval(uint32_t min_interval) { this->min_interval_ = min_interval; }
+  bool is_enabled() const { return this->duplicate_window_ > 0 || this->min_interval_ > 0; }
+
+  /// Check whether the advertisement or scan response should be forwarded, and remember it as forwarded if so.
+  bool should_forward(uint64_t address, bool scan_response, const uint8_t *data, size_t length, uint32_t now);
+
+  uint32_t get_forwarded() const { return this->forwarded_; }
+  uint32_t get_duplicates() const { return this->duplicates_; }
+  uint32_t get_rate_limited() const { return this->rate_limited_; }
+
+ protected:
+  struct Entry {
+    /// The MAC address with USED and for scan responses SCAN_RESPONSE set, 0 for a slot that was never used.
+    uint64_t key;
+    uint32_t data_hash;
+    uint32_t last_forwarded;
+  };
+
+  static const uint64_t USED = 1ULL << 63;
+  static const uint64_t SCAN_RESPONSE = 1ULL << 62;
+  static const size_t CAPACITY = 256;  // must be a power of two
+  static const size_t MAX_PROBE = 8;
+
+  std::vector<Entry> entries_;
+  uint32_t duplicate_window_{0};
+  uint32_t min_interval_{0};
+  uint32_t forwarded_{0};
+  uint32_t duplicates_{0};
+  uint32_t rate_limited_{0};
+};
+
+}  // namespace bluetooth_proxy
+}  // namespace esphome
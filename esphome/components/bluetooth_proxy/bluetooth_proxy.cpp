@@ -1,8 +1,11 @@
 #include "bluetooth_proxy.h"
 
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/macros.h"
 
+#include <cinttypes>
+
 #ifdef USE_ESP32
 
 namespace esphome {
@@ -25,6 +28,13 @@ std::vector<uint64_t> get_128bit_uuid_vec(esp_bt_uuid_t uuid_source) {
 
 BluetoothProxy::BluetoothProxy() { global_bluetooth_proxy = this; }
 
+void BluetoothProxy::setup() {
+#ifdef USE_SENSOR
+  if (this->forwarded_advertisements_sensor_ != nullptr || this->suppressed_advertisements_sensor_ != nullptr)
+    this->set_interval("advertisement_stats", 60000, [this]() { this->publish_advertisement_stats_(); });
+#endif
+}
+
 bool BluetoothProxy::parse_device(const esp32_ble_tracker::ESPBTDevice &device) {
   if (!api::global_api_server->is_connected() || this->api_connection_ == nullptr || this->raw_advertisements_)
     return false;
@@ -39,15 +49,21 @@ bool BluetoothProxy::parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_p
   if (!api::global_api_server->is_connected() || this->api_connection_ == nullptr || !this->raw_advertisements_)
     return false;
 
+  const uint32_t now = millis();
   api::BluetoothLERawAdvertisementsResponse resp;
   for (size_t i = 0; i < count; i++) {
     auto &result = advertisements[i];
+    uint64_t address = esp32_ble::ble_addr_to_uint64(result.bda);
+    uint8_t length = result.adv_data_len + result.scan_rsp_len;
+    const bool scan_response = result.ble_evt_type == ESP_BLE_EVT_SCAN_RSP;
+    if (!this->filter_.should_forward(address, scan_response, result.ble_adv, length, now))
+      continue;
+
     api::BluetoothLERawAdvertisement adv;
-    adv.address = esp32_ble::ble_addr_to_uint64(result.bda);
+    adv.address = address;
     adv.rssi = result.rssi;
     adv.address_type = result.ble_addr_type;
 
-    uint8_t length = result.adv_data_len + result.scan_rsp_len;
     adv.data.reserve(length);
     for (uint16_t i = 0; i < length; i++) {
       adv.data.push_back(result.ble_adv[i]);
@@ -58,7 +74,9 @@ bool BluetoothProxy::parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_p
     ESP_LOGV(TAG, "Proxying raw packet from %02X:%02X:%02X:%02X:%02X:%02X, length %d. RSSI: %d dB", result.bda[0],
              result.bda[1], result.bda[2], result.bda[3], result.bda[4], result.bda[5], length, result.rssi);
   }
-  ESP_LOGV(TAG, "Proxying %d packets", count);
+  if (resp.advertisements.empty())
+    return true;
+  ESP_LOGV(TAG, "Proxying %d of %d packets", resp.advertisements.size(), count);
   this->api_connection_->send_bluetooth_le_raw_advertisements_response(resp);
   return true;
 }
@@ -92,6 +110,25 @@ void BluetoothProxy::dump_config() {
   ESP_LOGCONFIG(TAG, "  Active: %s", YESNO(this->active_));
   ESP_LOGCONFIG(TAG, "  Connections: %d", this->connections_.size());
   ESP_LOGCONFIG(TAG, "  Raw advertisements: %s", YESNO(this->raw_advertisements_));
+  if (this->filter_.is_enabled()) {
+    ESP_LOGCONFIG(TAG, "  Advertisements forwarded: %" PRIu32 ", duplicates: %" PRIu32 ", rate limited: %" PRIu32,
+                  this->filter_.get_forwarded(), this->filter_.get_duplicates(), this->filter_.get_rate_limited());
+  }
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Forwarded Advertisements", this->forwarded_advertisements_sensor_);
+  LOG_SENSOR("  ", "Suppressed Advertisements", this->suppressed_advertisements_sensor_);
+#endif
+}
+
+void BluetoothProxy::publish_advertisement_stats_() {
+#ifdef USE_SENSOR
+  if (this->forwarded_advertisements_sensor_ != nullptr)
+    this->forwarded_advertisements_sensor_->publish_state(this->filter_.get_forwarded());
+  if (this->suppressed_advertisements_sensor_ != nullptr) {
+    this->suppressed_advertisements_sensor_->publish_state(this->filter_.get_duplicates() +
+                                                           this->filter_.get_rate_limited());
+  }
+#endif
 }
 
 int BluetoothProxy::get_bluetooth_connections_free() {
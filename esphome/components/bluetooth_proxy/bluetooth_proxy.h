@@ -13,6 +13,11 @@
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+#include "advertisement_filter.h"
 #include "bluetooth_connection.h"
 
 namespace esphome {
@@ -47,6 +52,7 @@ enum BluetoothProxySubscriptionFlag : uint32_t {
 class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Component {
  public:
   BluetoothProxy();
+  void setup() override;
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
   bool parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_param *advertisements, size_t count) override;
   void dump_config() override;
@@ -91,6 +97,16 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   }
 
   void set_active(bool active) { this->active_ = active; }
+  void set_duplicate_window(uint32_t duplicate_window) { this->filter_.set_duplicate_window(duplicate_window); }
+  void set_min_interval(uint32_t min_interval) { this->filter_.set_min_interval(min_interval); }
+#ifdef USE_SENSOR
+  void set_forwarded_advertisements_sensor(sensor::Sensor *forwarded_advertisements_sensor) {
+    this->forwarded_advertisements_sensor_ = forwarded_advertisements_sensor;
+  }
+  void set_suppressed_advertisements_sensor(sensor::Sensor *suppressed_advertisements_sensor) {
+    this->suppressed_advertisements_sensor_ = suppressed_advertisements_sensor;
+  }
+#endif
   bool has_active() { return this->active_; }
 
   uint32_t get_legacy_version() const {
@@ -118,12 +134,18 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   void send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device);
 
   BluetoothConnection *get_connection_(uint64_t address, bool reserve);
+  void publish_advertisement_stats_();
 
   bool active_;
 
   std::vector<BluetoothConnection *> connections_{};
   api::APIConnection *api_connection_{nullptr};
   bool raw_advertisements_{false};
+  AdvertisementFilter filter_;
+#ifdef USE_SENSOR
+  sensor::Sensor *forwarded_advertisements_sensor_{nullptr};
+  sensor::Sensor *suppressed_advertisements_sensor_{nullptr};
+#endif
 };
 
 extern BluetoothProxy *global_bluetooth_proxy;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -0,0 +1,45 @@
+import esphome.codegen as cg
+from esphome.components import sensor
+import esphome.config_validation as cv
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_BLUETOOTH,
+    ICON_COUNTER,
+    STATE_CLASS_TOTAL_INCREASING,
+)
+
+from . import BluetoothProxy
+
+DEPENDENCIES = ["bluetooth_proxy"]
+
+CONF_BLUETOOTH_PROXY_ID = "bluetooth_proxy_id"
+CONF_FORWARDED_ADVERTISEMENTS = "forwarded_advertisements"
+CONF_SUPPRESSED_ADVERTISEMENTS = "suppressed_advertisements"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_BLUETOOTH_PROXY_ID): cv.use_id(BluetoothProxy),
+        cv.Optional(CONF_FORWARDED_ADVERTISEMENTS): sensor.sensor_schema(
+            icon=ICON_BLUETOOTH,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_SUPPRESSED_ADVERTISEMENTS): sensor.sensor_schema(
+            icon=ICON_COUNTER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_BLUETOOTH_PROXY_ID])
+    if forwarded_config := config.get(CONF_FORWARDED_ADVERTISEMENTS):
+        sens = await sensor.new_sensor(forwarded_config)
+        cg.add(parent.set_forwarded_advertisements_sensor(sens))
+    if suppressed_config := config.get(CONF_SUPPRESSED_ADVERTISEMENTS):
+        sens = await sensor.new_sensor(suppressed_config)
+        cg.add(parent.set_suppressed_advertisements_sensor(sens))
@@ -1,6 +1,7 @@
 #include "debug_component.h"
 
 #include <algorithm>
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -28,7 +29,12 @@ void DebugComponent::dump_config() {
 #if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   LOG_SENSOR("  ", "Heap fragmentation", this->fragmentation_sensor_);
 #endif  // defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
+  LOG_SENSOR("  ", "Loop utilization", this->loop_utilization_sensor_);
+  LOG_SENSOR("  ", "Busiest component load", this->busiest_component_load_sensor_);
 #endif  // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+  LOG_TEXT_SENSOR("  ", "Busiest component", this->busiest_component_);
+#endif  // USE_TEXT_SENSOR
 
   std::string device_info;
   device_info.reserve(256);
@@ -84,9 +90,55 @@ void DebugComponent::update() {
   }
 
 #endif  // USE_SENSOR
+#ifdef USE_LOOP_PROFILER
+  this->update_profiler_();
+#endif  // USE_LOOP_PROFILER
   update_platform_();
 }
 
+#ifdef USE_LOOP_PROFILER
+void DebugComponent::update_profiler_() {
+  const uint32_t now = millis();
+  const uint64_t window_us = uint64_t(now - this->last_profiler_update_) * 1000;
+  this->last_profiler_update_ = now;
+
+  const auto &components = App.get_components();
+  this->profiler_totals_.resize(components.size(), 0);
+  uint64_t busy_us = 0;
+  uint64_t busiest_us = 0;
+  Component *busiest = nullptr;
+  for (size_t i = 0; i < components.size(); i++) {
+    Component *component = components[i];
+    uint64_t total =
+        component->get_loop_histogram().get_total_us() + component->get_scheduler_histogram().get_total_us();
+    uint64_t delta = total - this->profiler_totals_[i];
+    this->profiler_totals_[i] = total;
+    busy_us += delta;
+    if (delta > busiest_us) {
+      busiest_us = delta;
+      busiest = component;
+    }
+  }
+  if (window_us == 0)
+    return;
+
+  if (busiest != nullptr) {
+    ESP_LOGD(TAG, "Busiest component: %s (%.1f%% of the last %" PRIu32 " ms)", busiest->get_component_source(),
+             busiest_us * 100.0f / window_us, uint32_t(window_us / 1000));
+  }
+#ifdef USE_SENSOR
+  if (this->loop_utilization_sensor_ != nullptr)
+    this->loop_utilization_sensor_->publish_state(busy_us * 100.0f / window_us);
+  if (this->busiest_component_load_sensor_ != nullptr)
+    this->busiest_component_load_sensor_->publish_state(busiest_us * 100.0f / window_us);
+#endif  // USE_SENSOR
+#ifdef USE_TEXT_SENSOR
+  if (this->busiest_component_ != nullptr && busiest != nullptr)
+    this->busiest_component_->publish_state(busiest->get_component_source());
+#endif  // USE_TEXT_SENSOR
+}
+#endif  // USE_LOOP_PROFILER
+
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
 
 }  // namespace debug
@@ -25,6 +25,9 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   void set_device_info_sensor(text_sensor::TextSensor *device_info) { device_info_ = device_info; }
   void set_reset_reason_sensor(text_sensor::TextSensor *reset_reason) { reset_reason_ = reset_reason; }
+  void set_busiest_component_sensor(text_sensor::TextSensor *busiest_component) {
+    busiest_component_ = busiest_component;
+  }
 #endif  // USE_TEXT_SENSOR
 #ifdef USE_SENSOR
   void set_free_sensor(sensor::Sensor *free_sensor) { free_sensor_ = free_sensor; }
@@ -33,6 +36,12 @@ class DebugComponent : public PollingComponent {
   void set_fragmentation_sensor(sensor::Sensor *fragmentation_sensor) { fragmentation_sensor_ = fragmentation_sensor; }
 #endif
   void set_loop_time_sensor(sensor::Sensor *loop_time_sensor) { loop_time_sensor_ = loop_time_sensor; }
+  void set_loop_utilization_sensor(sensor::Sensor *loop_utilization_sensor) {
+    loop_utilization_sensor_ = loop_utilization_sensor;
+  }
+  void set_busiest_component_load_sensor(sensor::Sensor *busiest_component_load_sensor) {
+    busiest_component_load_sensor_ = busiest_component_load_sensor;
+  }
 #ifdef USE_ESP32
   void set_psram_sensor(sensor::Sensor *psram_sensor) { this->psram_sensor_ = psram_sensor; }
 #endif  // USE_ESP32
@@ -50,6 +59,8 @@ class DebugComponent : public PollingComponent {
   sensor::Sensor *fragmentation_sensor_{nullptr};
 #endif
   sensor::Sensor *loop_time_sensor_{nullptr};
+  sensor::Sensor *loop_utilization_sensor_{nullptr};
+  sensor::Sensor *busiest_component_load_sensor_{nullptr};
 #ifdef USE_ESP32
   sensor::Sensor *psram_sensor_{nullptr};
 #endif  // USE_ESP32
@@ -58,8 +69,17 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_TEXT_SENSOR
   text_sensor::TextSensor *device_info_{nullptr};
   text_sensor::TextSensor *reset_reason_{nullptr};
+  text_sensor::TextSensor *busiest_component_{nullptr};
 #endif  // USE_TEXT_SENSOR
 
+#ifdef USE_LOOP_PROFILER
+  /// Total loop and scheduler time per component at the previous update, indexed like App.get_components().
+  std::vector<uint64_t> profiler_totals_{};
+  uint32_t last_profiler_update_{0};
+
+  void update_profiler_();
+#endif  // USE_LOOP_PROFILER
+
   std::string get_reset_reason_();
   uint32_t get_free_heap_();
   void get_device_info_(std::string &device_info);
@@ -18,6 +18,8 @@ from . import CONF_DEBUG_ID, DebugComponent
 DEPENDENCIES = ["debug"]
 
 CONF_PSRAM = "psram"
+CONF_LOOP_UTILIZATION = "loop_utilization"
+CONF_BUSIEST_COMPONENT_LOAD = "busiest_component_load"
 
 CONFIG_SCHEMA = {
     cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -49,6 +51,18 @@ CONFIG_SCHEMA = {
         accuracy_decimals=0,
         entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
+    cv.Optional(CONF_LOOP_UTILIZATION): sensor.sensor_schema(
+        unit_of_measurement=UNIT_PERCENT,
+        icon=ICON_TIMER,
+        accuracy_decimals=1,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_BUSIEST_COMPONENT_LOAD): sensor.sensor_schema(
+        unit_of_measurement=UNIT_PERCENT,
+        icon=ICON_TIMER,
+        accuracy_decimals=1,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
     cv.Optional(CONF_PSRAM): cv.All(
         cv.only_on_esp32,
         cv.requires_component("psram"),
@@ -81,6 +95,16 @@ async def to_code(config):
         sens = await sensor.new_sensor(loop_time_conf)
         cg.add(debug_component.set_loop_time_sensor(sens))
 
+    if loop_utilization_conf := config.get(CONF_LOOP_UTILIZATION):
+        sens = await sensor.new_sensor(loop_utilization_conf)
+        cg.add(debug_component.set_loop_utilization_sensor(sens))
+        cg.add_define("USE_LOOP_PROFILER")
+
+    if busiest_component_load_conf := config.get(CONF_BUSIEST_COMPONENT_LOAD):
+        sens = await sensor.new_sensor(busiest_component_load_conf)
+        cg.add(debug_component.set_busiest_component_load_sensor(sens))
+        cg.add_define("USE_LOOP_PROFILER")
+
     if psram_conf := config.get(CONF_PSRAM):
         sens = await sensor.new_sensor(psram_conf)
         cg.add(debug_component.set_psram_sensor(sens))
@@ -0,0 +1,99 @@
+#include "dirty_tiles.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace display {
+
+void DirtyTiles::init(int width, int height, uint8_t bytes_per_pixel, int tile_size) {
+  this->width_ = width;
+  this->height_ = height;
+  this->bytes_per_pixel_ = bytes_per_pixel;
+  this->tile_size_ = tile_size;
+  this->cols_ = (width + tile_size - 1) / tile_size;
+  this->rows_ = (height + tile_size - 1) / tile_size;
+  this->hashes_.assign(this->cols_ * this->rows_, 0);
+  this->valid_.assign(this->cols_ * this->rows_, false);
+  this->changes_.clear();
+}
+
+void DirtyTiles::invalidate(const Rect &region) {
+  if (!this->is_initialized() || region.w <= 0 || region.h <= 0)
+    return;
+  int col_start = std::max(0, (int) region.x) / this->tile_size_;
+  int col_end = std::min(this->width_ - 1, region.x2() - 1) / this->tile_size_;
+  int row_start = std::max(0, (int) region.y) / this->tile_size_;
+  int row_end = std::min(this->height_ - 1, region.y2() - 1) / this->tile_size_;
+  for (int row = row_start; row <= row_end; row++) {
+    for (int col = col_start; col <= col_end; col++)
+      this->valid_[row * this->cols_ + col] = false;
+  }
+}
+
+const std::vector<Rect> &DirtyTiles::find_changes(const uint8_t *buffer, const Rect &region) {
+  this->changes_.clear();
+  if (!this->is_initialized() || region.w <= 0 || region.h <= 0)
+    return this->changes_;
+
+  int col_start = std::max(0, (int) region.x) / this->tile_size_;
+  int col_end = std::min(this->width_ - 1, region.x2() - 1) / this->tile_size_;
+  int row_start = std::max(0, (int) region.y) / this->tile_size_;
+  int row_end = std::min(this->height_ - 1, region.y2() - 1) / this->tile_size_;
+  for (int row = row_start; row <= row_end; row++) {
+    int run_start = -1;
+    for (int col = col_start; col <= col_end; col++) {
+      size_t index = row * this->cols_ + col;
+      uint32_t hash = this->hash_tile_(buffer, col, row);
+      if (this->valid_[index] && this->hashes_[index] == hash) {
+        if (run_start >= 0)
+          this->add_change_(run_start, col, row);
+        run_start = -1;
+        continue;
+      }
+      this->hashes_[index] = hash;
+      this->valid_[index] = true;
+      if (run_start < 0)
+        run_start = col;
+    }
+    if (run_start >= 0)
+      this->add_change_(run_start, col_end + 1, row);
+  }
+  return this->changes_;
+}
+
+uint32_t DirtyTiles::hash_tile_(const uint8_t *buffer, int col, int row) const {
+  int x = col * this->tile_size_;
+  int y = row * this->tile_size_;
+  size_t row_bytes = std::min(this->tile_size_, this->width_ - x) * this->bytes_per_pixel_;
+  int y_end = std::min(y + this->tile_size_, this->height_);
+  size_t stride = this->width_ * this->bytes_per_pixel_;
+
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (; y < y_end; y++) {
+    const uint8_t *pos = buffer + y * stride + x * this->bytes_per_pixel_;
+    for (size_t i = 0; i < row_bytes; i++) {
+      hash ^= pos[i];
+      hash *= 16777619UL;
+    }
+  }
+  return hash;
+}
+
+void DirtyTiles::add_change_(int col_start, int col_end, int row) {
+  int16_t x = col_start * this->tile_size_;
+  int16_t y = row * this->tile_size_;
+  int16_t w = std::min(col_end * this->tile_size_, this->width_) - x;
+  int16_t h = std::min(y + this->tile_size_, this->height_) - y;
+  // Grow a change of the tile row above that covers the same columns
+  for (auto &change : this->changes_) {
+    if (change.x == x && change.w == w && change.y2() == y) {
+      change.h += h;
+      return;
+    }
+  }
+  this->changes_.emplace_back(x, y, w, h);
+}
+
+}  // namespace display
+}  // namespace esphome
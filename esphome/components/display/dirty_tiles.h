@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "rect.h"
+
+namespace esphome {
+namespace display {
+
+/** Finds the parts of a row-major frame buffer that changed since they were last sent to the display.
+ *
+ * The buffer is split into square tiles and a hash of every tile is kept from the last flush. After a frame has been
+ * drawn, only the tiles whose contents differ are reported, merged into rectangles of adjacent tiles. A frame that is
+ * cleared and redrawn with mostly the same contents therefore only sends the parts that really changed.
+ *
+ * Can be used by any DisplayBuffer driver whose buffer stores whole bytes per pixel, row by row.
+ */
+class DirtyTiles {
+ public:
+  /// Set up for a buffer of width x height pixels, using bytes_per_pixel bytes each.
+  void init(int width, int height, uint8_t bytes_per_pixel, int tile_size = 32);
+  bool is_initialized() const { return !this->hashes_.empty(); }
+
+  /// Report all tiles overlapping region as changed on the next call to find_changes().
+  void invalidate(const Rect &region);
+
+  /** Compare the tiles overlapping region with the last flush.
+   *
+   * Returns the changed areas in buffer coordinates, clipped to the buffer. The caller is expected to send all of them
+   * to the display, as they are remembered as flushed.
+   */
+  const std::vector<Rect> &find_changes(const uint8_t *buffer, const Rect &region);
+
+ protected:
+  uint32_t hash_tile_(const uint8_t *buffer, int col, int row) const;
+  void add_change_(int col_start, int col_end, int row);
+
+  std::vector<uint32_t> hashes_;
+  std::vector<bool> valid_;
+  std::vector<Rect> changes_;
+  int width_{0};
+  int height_{0};
+  int tile_size_{0};
+  int cols_{0};
+  int rows_{0};
+  uint8_t bytes_per_pixel_{0};
+};
+
+}  // namespace display
+}  // namespace esphome
@@ -267,7 +267,7 @@ class Display : public PollingComponent {
   void line_at_angle(int x, int y, int angle, int start_radius, int stop_radius, Color color = COLOR_ON);
 
   /// Draw a horizontal line from the point [x,y] to [x+width,y] with the given color.
-  void horizontal_line(int x, int y, int width, Color color = COLOR_ON);
+  virtual void horizontal_line(int x, int y, int width, Color color = COLOR_ON);
 
   /// Draw a vertical line from the point [x,y] to [x,y+width] with the given color.
   void vertical_line(int x, int y, int height, Color color = COLOR_ON);
@@ -657,6 +657,45 @@ class Display : public PollingComponent {
   void show_test_card() { this->show_test_card_ = true; }
 
  protected:
+  /// Read the pixel at index from a buffer in the format used by draw_pixels_at(). Pixels are opaque and RGB565 is
+  /// expanded by bit replication, the same colors Image::get_pixel() returns, so an image drawn in bulk looks the same
+  /// as one drawn pixel by pixel.
+  static inline Color read_pixel_(const uint8_t *ptr, size_t index, ColorOrder order, ColorBitness bitness,
+                                  bool big_endian) {
+    uint8_t first, second, third;
+    switch (bitness) {
+      default: {
+        Color color = ColorUtil::to_color(ptr[index], order, bitness);
+        color.w = 0xFF;
+        return color;
+      }
+      case COLOR_BITNESS_565: {
+        ptr += index * 2;
+        uint16_t value = big_endian ? (ptr[0] << 8) | ptr[1] : ptr[0] | (ptr[1] << 8);
+        first = (value >> 11) & 0x1F;
+        second = (value >> 5) & 0x3F;
+        third = value & 0x1F;
+        first = (first << 3) | (first >> 2);
+        second = (second << 2) | (second >> 4);
+        third = (third << 3) | (third >> 2);
+        break;
+      }
+      case COLOR_BITNESS_888:
+        ptr += index * 3;
+        first = big_endian ? ptr[0] : ptr[2];
+        second = ptr[1];
+        third = big_endian ? ptr[2] : ptr[0];
+        break;
+    }
+    switch (order) {
+      default:
+        return Color(first, second, third, 0xFF);
+      case COLOR_ORDER_BGR:
+        return Color(third, second, first, 0xFF);
+      case COLOR_ORDER_GRB:
+        return Color(second, first, third, 0xFF);
+    }
+  }
   bool clamp_x_(int x, int w, int &min_x, int &max_x);
   bool clamp_y_(int y, int h, int &min_y, int &max_y);
   void vprintf_(int x, int y, BaseFont *font, Color color, Color background, TextAlign align, const char *format,
@@ -1,5 +1,6 @@
 #include "display_buffer.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "esphome/core/application.h"
@@ -48,25 +49,49 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
   if (!this->get_clipping().inside(x, y))
     return;  // NOLINT
 
-  switch (this->rotation_) {
-    case DISPLAY_ROTATION_0_DEGREES:
-      break;
-    case DISPLAY_ROTATION_90_DEGREES:
-      std::swap(x, y);
-      x = this->get_width_internal() - x - 1;
-      break;
-    case DISPLAY_ROTATION_180_DEGREES:
-      x = this->get_width_internal() - x - 1;
-      y = this->get_height_internal() - y - 1;
-      break;
-    case DISPLAY_ROTATION_270_DEGREES:
-      std::swap(x, y);
-      y = this->get_height_internal() - y - 1;
-      break;
+  this->draw_rotated_pixel_(x, y, color);
+  App.feed_wdt();
+}
+
+void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
+  int x1 = std::max(x, 0);
+  int x2 = std::min(x + width, this->get_width()) - 1;
+  if (y < 0 || y >= this->get_height())
+    return;
+  auto clipping = this->get_clipping();
+  if (clipping.is_set()) {
+    if (y < clipping.y || y > clipping.y2())
+      return;
+    x1 = std::max(x1, (int) clipping.x);
+    x2 = std::min(x2, (int) clipping.x2());
   }
-  this->draw_absolute_pixel_internal(x, y, color);
+  for (x = x1; x <= x2; x++)
+    this->draw_rotated_pixel_(x, y, color);
   App.feed_wdt();
 }
 
+void HOT DisplayBuffer::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                                       ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) {
+  int x1 = std::max(x_start, 0);
+  int x2 = std::min(x_start + w, this->get_width()) - 1;
+  int y1 = std::max(y_start, 0);
+  int y2 = std::min(y_start + h, this->get_height()) - 1;
+  auto clipping = this->get_clipping();
+  if (clipping.is_set()) {
+    x1 = std::max(x1, (int) clipping.x);
+    x2 = std::min(x2, (int) clipping.x2());
+    y1 = std::max(y1, (int) clipping.y);
+    y2 = std::min(y2, (int) clipping.y2());
+  }
+  size_t line_stride = x_offset + w + x_pad;  // length of each source line in pixels
+  for (int y = y1; y <= y2; y++) {
+    size_t source_idx = (y_offset + y - y_start) * line_stride + x_offset + x1 - x_start;
+    for (int x = x1; x <= x2; x++, source_idx++) {
+      this->draw_rotated_pixel_(x, y, read_pixel_(ptr, source_idx, order, bitness, big_endian));
+    }
+    App.feed_wdt();
+  }
+}
+
 }  // namespace display
 }  // namespace esphome
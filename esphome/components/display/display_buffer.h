@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdarg>
+#include <utility>
 #include <vector>
 
 #include "display.h"
@@ -21,10 +22,37 @@ class DisplayBuffer : public Display {
 
   /// Set a single pixel at the specified coordinates to the given color.
   void draw_pixel_at(int x, int y, Color color) override;
+  /// Draw a horizontal line, clipping and rotating once for the whole line instead of for every pixel.
+  void horizontal_line(int x, int y, int width, Color color = COLOR_ON) override;
+  /// Draw pixels from a buffer, clipping and rotating once for the whole area instead of for every pixel.
+  void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                      ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override;
+  using Display::draw_pixels_at;
 
  protected:
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /// Draw a pixel at coordinates with rotation applied, that are known to be inside the clipping region.
+  inline void draw_rotated_pixel_(int x, int y, Color color) {
+    switch (this->rotation_) {
+      case DISPLAY_ROTATION_0_DEGREES:
+        break;
+      case DISPLAY_ROTATION_90_DEGREES:
+        std::swap(x, y);
+        x = this->get_width_internal() - x - 1;
+        break;
+      case DISPLAY_ROTATION_180_DEGREES:
+        x = this->get_width_internal() - x - 1;
+        y = this->get_height_internal() - y - 1;
+        break;
+      case DISPLAY_ROTATION_270_DEGREES:
+        std::swap(x, y);
+        y = this->get_height_internal() - y - 1;
+        break;
+    }
+    this->draw_absolute_pixel_internal(x, y, color);
+  }
+
   void init_internal_(uint32_t buffer_length);
 
   uint8_t *buffer_{nullptr};
@@ -9,6 +9,8 @@
 #include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 #include <esp_bt.h>
 #include <esp_bt_device.h>
 #include <esp_bt_main.h>
@@ -329,19 +331,42 @@ void ESP32BLE::loop() {
     EVENT_ALLOCATOR.deallocate(ble_event, 1);
     ble_event = this->ble_events_.pop();
   }
+  const uint32_t dropped = this->events_dropped_.load(std::memory_order_relaxed);
+  if (dropped != this->events_dropped_reported_ && millis() - this->last_drop_warning_ >= 10000) {
+    ESP_LOGW(TAG, "Out of memory for BLE events, dropped %" PRIu32 " events", dropped - this->events_dropped_reported_);
+    this->events_dropped_reported_ = dropped;
+    this->last_drop_warning_ = millis();
+  }
   if (this->advertising_ != nullptr) {
     this->advertising_->loop();
   }
 }
 
 void ESP32BLE::gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+  if (event == ESP_GAP_BLE_SCAN_RESULT_EVT && param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT &&
+      global_ble->scan_results_.is_initialized()) {
+    // Scan results come in far more often than any other event, copy them into the ring instead of allocating
+    global_ble->scan_results_received_.fetch_add(1, std::memory_order_relaxed);
+    if (!global_ble->scan_results_.push(param->scan_rst)) {
+      // The consumer has not caught up yet, drop the newest result rather than blocking the BT task
+      global_ble->scan_results_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+#ifdef USE_LOOP_EVENT_DRIVEN
+    App.wake_loop();
+#endif
+    return;
+  }
   BLEEvent *new_event = EVENT_ALLOCATOR.allocate(1);
   if (new_event == nullptr) {
     // Memory too fragmented to allocate new event. Can only drop it until memory comes back
+    global_ble->events_dropped_.fetch_add(1, std::memory_order_relaxed);
     return;
   }
   new (new_event) BLEEvent(event, param);
   global_ble->ble_events_.push(new_event);
+#ifdef USE_LOOP_EVENT_DRIVEN
+  App.wake_loop();
+#endif
 }  // NOLINT(clang-analyzer-unix.Malloc)
 
 void ESP32BLE::real_gap_event_handler_(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
@@ -356,10 +381,14 @@ void ESP32BLE::gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gat
   BLEEvent *new_event = EVENT_ALLOCATOR.allocate(1);
   if (new_event == nullptr) {
     // Memory too fragmented to allocate new event. Can only drop it until memory comes back
+    global_ble->events_dropped_.fetch_add(1, std::memory_order_relaxed);
     return;
   }
   new (new_event) BLEEvent(event, gatts_if, param);
   global_ble->ble_events_.push(new_event);
+#ifdef USE_LOOP_EVENT_DRIVEN
+  App.wake_loop();
+#endif
 }  // NOLINT(clang-analyzer-unix.Malloc)
 
 void ESP32BLE::real_gatts_event_handler_(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if,
@@ -375,10 +404,14 @@ void ESP32BLE::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gat
   BLEEvent *new_event = EVENT_ALLOCATOR.allocate(1);
   if (new_event == nullptr) {
     // Memory too fragmented to allocate new event. Can only drop it until memory comes back
+    global_ble->events_dropped_.fetch_add(1, std::memory_order_relaxed);
     return;
   }
   new (new_event) BLEEvent(event, gattc_if, param);
   global_ble->ble_events_.push(new_event);
+#ifdef USE_LOOP_EVENT_DRIVEN
+  App.wake_loop();
+#endif
 }  // NOLINT(clang-analyzer-unix.Malloc)
 
 void ESP32BLE::real_gattc_event_handler_(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
@@ -419,6 +452,7 @@ void ESP32BLE::dump_config() {
     ESP_LOGCONFIG(TAG, "  MAC address: %02X:%02X:%02X:%02X:%02X:%02X", mac_address[0], mac_address[1], mac_address[2],
                   mac_address[3], mac_address[4], mac_address[5]);
     ESP_LOGCONFIG(TAG, "  IO Capability: %s", io_capability_s);
+    ESP_LOGCONFIG(TAG, "  Events dropped: %" PRIu32, this->events_dropped_.load(std::memory_order_relaxed));
   } else {
     ESP_LOGCONFIG(TAG, "ESP32 BLE: bluetooth stack is not enabled");
   }
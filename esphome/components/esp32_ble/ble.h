@@ -3,6 +3,7 @@
 #include "ble_advertising.h"
 #include "ble_uuid.h"
 
+#include <atomic>
 #include <functional>
 
 #include "esphome/core/automation.h"
@@ -52,6 +53,14 @@ enum BLEComponentState {
   BLE_COMPONENT_STATE_ACTIVE,
 };
 
+#ifdef USE_PSRAM
+static const uint8_t SCAN_RESULT_BUFFER_SIZE = 64;
+#else
+static const uint8_t SCAN_RESULT_BUFFER_SIZE = 32;
+#endif  // USE_PSRAM
+
+using ScanResultRing = SPSCRing<esp_ble_gap_cb_param_t::ble_scan_result_evt_param, SCAN_RESULT_BUFFER_SIZE>;
+
 class GAPEventHandler {
  public:
   virtual void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) = 0;
@@ -107,6 +116,17 @@ class ESP32BLE : public Component {
   }
   void set_enable_on_boot(bool enable_on_boot) { this->enable_on_boot_ = enable_on_boot; }
 
+  /** Deliver scan results through a ring read by the consumer's loop(), instead of the event queue.
+   *
+   * Must be called before BLE is enabled. The ESP_GAP_SEARCH_INQ_RES_EVT scan results are then copied straight from
+   * the BT task into the ring and are no longer passed to the GAP event handlers.
+   */
+  bool enable_scan_result_ring() { return this->scan_results_.init(); }
+  ScanResultRing &get_scan_results() { return this->scan_results_; }
+  /// Scan results received by the BT task, and those of them dropped because the ring was full.
+  uint32_t get_scan_results_received() const { return this->scan_results_received_.load(std::memory_order_relaxed); }
+  uint32_t get_scan_results_dropped() const { return this->scan_results_dropped_.load(std::memory_order_relaxed); }
+
  protected:
   static void gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param);
   static void gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if, esp_ble_gattc_cb_param_t *param);
@@ -128,6 +148,13 @@ class ESP32BLE : public Component {
   BLEComponentState state_{BLE_COMPONENT_STATE_OFF};
 
   Queue<BLEEvent> ble_events_;
+  ScanResultRing scan_results_;
+  std::atomic<uint32_t> scan_results_received_{0};
+  std::atomic<uint32_t> scan_results_dropped_{0};
+  /// Events dropped on the BT task because no BLEEvent could be allocated.
+  std::atomic<uint32_t> events_dropped_{0};
+  uint32_t events_dropped_reported_{0};
+  uint32_t last_drop_warning_{0};
   BLEAdvertising *advertising_;
   esp_ble_io_cap_t io_cap_{ESP_IO_CAP_NONE};
   uint32_t advertising_cycle_time_;
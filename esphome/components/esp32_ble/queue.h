@@ -2,9 +2,13 @@
 
 #ifdef USE_ESP32
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <queue>
 
+#include "esphome/core/helpers.h"
+
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 
@@ -50,6 +54,56 @@ template<class T> class Queue {
   SemaphoreHandle_t m_;
 };
 
+/** Fixed size ring for events that come in too often to allocate each of them, like scan results.
+ *
+ * The BT task is the only producer and loop() the only consumer, so the ring needs no lock: an element is only
+ * published after it has been copied, and a slot is only reused after the consumer has moved past it. Both counters
+ * only ever increase, N is a power of two so that they can wrap around.
+ */
+template<class T, size_t N> class SPSCRing {
+  static_assert(N != 0 && (N & (N - 1)) == 0, "The ring size must be a power of two");
+
+ public:
+  bool init() {
+    ExternalRAMAllocator<T> allocator(ExternalRAMAllocator<T>::ALLOW_FAILURE);
+    this->buffer_ = allocator.allocate(N);
+    return this->buffer_ != nullptr;
+  }
+  bool is_initialized() const { return this->buffer_ != nullptr; }
+
+  /// Copy element into the ring, producer only. Returns false if the ring is full.
+  bool push(const T &element) {
+    const uint32_t head = this->head_.load(std::memory_order_relaxed);
+    if (head - this->tail_.load(std::memory_order_acquire) >= N)
+      return false;
+    this->buffer_[head % N] = element;
+    this->head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Point elements at the oldest unread elements and return how many of them are contiguous, consumer only.
+   *
+   * Once the ring has wrapped around, the rest follows on the next call after consume().
+   */
+  size_t peek(T **elements) {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    const uint32_t head = this->head_.load(std::memory_order_acquire);
+    const size_t start = tail % N;
+    *elements = this->buffer_ + start;
+    return std::min<size_t>(head - tail, N - start);
+  }
+
+  /// Give count elements returned by peek() back to the producer, consumer only.
+  void consume(size_t count) {
+    this->tail_.store(this->tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+  }
+
+ protected:
+  T *buffer_{nullptr};
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+};
+
 }  // namespace esp32_ble
 }  // namespace esphome
 
@@ -46,19 +46,19 @@ void ESP32BLETracker::setup() {
     ESP_LOGE(TAG, "BLE Tracker was marked failed by ESP32BLE");
     return;
   }
-  ExternalRAMAllocator<esp_ble_gap_cb_param_t::ble_scan_result_evt_param> allocator(
-      ExternalRAMAllocator<esp_ble_gap_cb_param_t::ble_scan_result_evt_param>::ALLOW_FAILURE);
-  this->scan_result_buffer_ = allocator.allocate(ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE);
-
-  if (this->scan_result_buffer_ == nullptr) {
+  if (!this->parent_->enable_scan_result_ring()) {
     ESP_LOGE(TAG, "Could not allocate buffer for BLE Tracker!");
     this->mark_failed();
   }
 
   global_esp32_ble_tracker = this;
-  this->scan_result_lock_ = xSemaphoreCreateMutex();
   this->scan_end_lock_ = xSemaphoreCreateMutex();
 
+#ifdef USE_SENSOR
+  if (this->scan_results_sensor_ != nullptr || this->dropped_scan_results_sensor_ != nullptr)
+    this->set_interval("scan_stats", 60000, [this]() { this->publish_scan_stats_(); });
+#endif
+
 #ifdef USE_OTA
   ota::get_global_ota_callback()->add_on_state_callback(
       [this](ota::OTAState state, float progress, uint8_t error, ota::OTAComponent *comp) {
@@ -118,26 +118,25 @@ void ESP32BLETracker::loop() {
   bool promote_to_connecting = discovered && !searching && !connecting;
 
   if (!this->scanner_idle_) {
-    if (this->scan_result_index_ &&  // if it looks like we have a scan result we will take the lock
-        xSemaphoreTake(this->scan_result_lock_, 5L / portTICK_PERIOD_MS)) {
-      uint32_t index = this->scan_result_index_;
-      if (index >= ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE) {
-        ESP_LOGW(TAG, "Too many BLE events to process. Some devices may not show up.");
-      }
-
+    // The BT task copies the scan results into this ring in ESP32BLE::gap_event_handler(). Hand them over in
+    // contiguous runs, bounded so that results arriving meanwhile wait for the next loop()
+    auto &ring = this->parent_->get_scan_results();
+    esp_ble_gap_cb_param_t::ble_scan_result_evt_param *results;
+    size_t count;
+    for (size_t pass = 0; pass < 2 && (count = ring.peek(&results)) != 0; pass++) {
       if (this->raw_advertisements_) {
         for (auto *listener : this->listeners_) {
-          listener->parse_devices(this->scan_result_buffer_, this->scan_result_index_);
+          listener->parse_devices(results, count);
         }
         for (auto *client : this->clients_) {
-          client->parse_devices(this->scan_result_buffer_, this->scan_result_index_);
+          client->parse_devices(results, count);
         }
       }
 
       if (this->parse_advertisements_) {
-        for (size_t i = 0; i < index; i++) {
+        for (size_t i = 0; i < count; i++) {
           ESPBTDevice device;
-          device.parse_scan_rst(this->scan_result_buffer_[i]);
+          device.parse_scan_rst(results[i]);
 
           bool found = false;
           for (auto *listener : this->listeners_) {
@@ -159,8 +158,16 @@ void ESP32BLETracker::loop() {
           }
         }
       }
-      this->scan_result_index_ = 0;
-      xSemaphoreGive(this->scan_result_lock_);
+      // Give the slots back to the BT task
+      ring.consume(count);
+    }
+
+    const uint32_t dropped = this->parent_->get_scan_results_dropped();
+    if (dropped != this->scan_results_dropped_reported_ && millis() - this->last_drop_warning_ >= 10000) {
+      ESP_LOGW(TAG, "Too many BLE events to process, dropped %" PRIu32 " scan results. Some devices may not show up.",
+               dropped - this->scan_results_dropped_reported_);
+      this->scan_results_dropped_reported_ = dropped;
+      this->last_drop_warning_ = millis();
     }
 
     /*
@@ -409,14 +416,8 @@ void ESP32BLETracker::gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_
 
 void ESP32BLETracker::gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
   ESP_LOGV(TAG, "gap_scan_result - event %d", param.search_evt);
-  if (param.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
-    if (xSemaphoreTake(this->scan_result_lock_, 0L)) {
-      if (this->scan_result_index_ < ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE) {
-        this->scan_result_buffer_[this->scan_result_index_++] = param;
-      }
-      xSemaphoreGive(this->scan_result_lock_);
-    }
-  } else if (param.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
+  // The results themselves (ESP_GAP_SEARCH_INQ_RES_EVT) bypass the event queue, see loop()
+  if (param.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
     xSemaphoreGive(this->scan_end_lock_);
   }
 }
@@ -687,6 +688,21 @@ void ESP32BLETracker::dump_config() {
   if (this->scan_start_fail_count_) {
     ESP_LOGCONFIG(TAG, "  Scan Start Fail Count: %d", this->scan_start_fail_count_);
   }
+  ESP_LOGCONFIG(TAG, "  Scan Results: %" PRIu32 ", dropped: %" PRIu32, this->parent_->get_scan_results_received(),
+                this->parent_->get_scan_results_dropped());
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Scan Results", this->scan_results_sensor_);
+  LOG_SENSOR("  ", "Dropped Scan Results", this->dropped_scan_results_sensor_);
+#endif
+}
+
+void ESP32BLETracker::publish_scan_stats_() {
+#ifdef USE_SENSOR
+  if (this->scan_results_sensor_ != nullptr)
+    this->scan_results_sensor_->publish_state(this->parent_->get_scan_results_received());
+  if (this->dropped_scan_results_sensor_ != nullptr)
+    this->dropped_scan_results_sensor_->publish_state(this->parent_->get_scan_results_dropped());
+#endif
 }
 
 void ESP32BLETracker::print_bt_device_info(const ESPBTDevice &device) {
@@ -21,6 +21,10 @@
 #include "esphome/components/esp32_ble/ble.h"
 #include "esphome/components/esp32_ble/ble_uuid.h"
 
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
 namespace esphome {
 namespace esp32_ble_tracker {
 
@@ -192,6 +196,12 @@ class ESP32BLETracker : public Component,
   void set_scan_window(uint32_t scan_window) { scan_window_ = scan_window; }
   void set_scan_active(bool scan_active) { scan_active_ = scan_active; }
   void set_scan_continuous(bool scan_continuous) { scan_continuous_ = scan_continuous; }
+#ifdef USE_SENSOR
+  void set_scan_results_sensor(sensor::Sensor *scan_results_sensor) { scan_results_sensor_ = scan_results_sensor; }
+  void set_dropped_scan_results_sensor(sensor::Sensor *dropped_scan_results_sensor) {
+    dropped_scan_results_sensor_ = dropped_scan_results_sensor;
+  }
+#endif
 
   /// Setup the FreeRTOS task and the Bluetooth stack.
   void setup() override;
@@ -220,7 +230,7 @@ class ESP32BLETracker : public Component,
   void start_scan_(bool first);
   /// Called when a scan ends
   void end_of_scan_();
-  /// Called when a `ESP_GAP_BLE_SCAN_RESULT_EVT` event is received.
+  /// Called when a `ESP_GAP_BLE_SCAN_RESULT_EVT` event other than a scan result is received.
   void gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT` event is received.
   void gap_scan_set_param_complete_(const esp_ble_gap_cb_param_t::ble_scan_param_cmpl_evt_param &param);
@@ -228,6 +238,7 @@ class ESP32BLETracker : public Component,
   void gap_scan_start_complete_(const esp_ble_gap_cb_param_t::ble_scan_start_cmpl_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_STOP_COMPLETE_EVT` event is received.
   void gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_scan_stop_cmpl_evt_param &param);
+  void publish_scan_stats_();
 
   int app_id_{0};
 
@@ -249,15 +260,13 @@ class ESP32BLETracker : public Component,
   bool ble_was_disabled_{true};
   bool raw_advertisements_{false};
   bool parse_advertisements_{false};
-  SemaphoreHandle_t scan_result_lock_;
   SemaphoreHandle_t scan_end_lock_;
-  size_t scan_result_index_{0};
-#ifdef USE_PSRAM
-  const static u_int8_t SCAN_RESULT_BUFFER_SIZE = 32;
-#else
-  const static u_int8_t SCAN_RESULT_BUFFER_SIZE = 16;
-#endif  // USE_PSRAM
-  esp_ble_gap_cb_param_t::ble_scan_result_evt_param *scan_result_buffer_;
+  uint32_t scan_results_dropped_reported_{0};
+  uint32_t last_drop_warning_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *scan_results_sensor_{nullptr};
+  sensor::Sensor *dropped_scan_results_sensor_{nullptr};
+#endif
   esp_bt_status_t scan_start_failed_{ESP_BT_STATUS_SUCCESS};
   esp_bt_status_t scan_set_param_failed_{ESP_BT_STATUS_SUCCESS};
   int connecting_{0};
@@ -0,0 +1,44 @@
+import esphome.codegen as cg
+from esphome.components import sensor
+import esphome.config_validation as cv
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_BLUETOOTH,
+    ICON_COUNTER,
+    STATE_CLASS_TOTAL_INCREASING,
+)
+
+from . import CONF_ESP32_BLE_ID, ESP32BLETracker
+
+DEPENDENCIES = ["esp32_ble_tracker"]
+
+CONF_SCAN_RESULTS = "scan_results"
+CONF_DROPPED_SCAN_RESULTS = "dropped_scan_results"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_ESP32_BLE_ID): cv.use_id(ESP32BLETracker),
+        cv.Optional(CONF_SCAN_RESULTS): sensor.sensor_schema(
+            icon=ICON_BLUETOOTH,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_DROPPED_SCAN_RESULTS): sensor.sensor_schema(
+            icon=ICON_COUNTER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_ESP32_BLE_ID])
+    if scan_results_config := config.get(CONF_SCAN_RESULTS):
+        sens = await sensor.new_sensor(scan_results_config)
+        cg.add(parent.set_scan_results_sensor(sens))
+    if dropped_scan_results_config := config.get(CONF_DROPPED_SCAN_RESULTS):
+        sens = await sensor.new_sensor(dropped_scan_results_config)
+        cg.add(parent.set_dropped_scan_results_sensor(sens))
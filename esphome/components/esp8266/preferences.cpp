@@ -12,6 +12,7 @@ extern "C" {
 #include "preferences.h"
 
 #include <cstring>
+#include <utility>
 #include <vector>
 
 namespace esphome {
@@ -22,6 +23,8 @@ static const char *const TAG = "esp8266.preferences";
 static bool s_prevent_write = false;         // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 static uint32_t *s_flash_storage = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 static bool s_flash_dirty = false;           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Next free word of the record log in the flash sector, 0 if the sector has to be rewritten on the next sync
+static uint32_t s_flash_log_end = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 static const uint32_t ESP_RTC_USER_MEM_START = 0x60001200;
 #define ESP_RTC_USER_MEM ((uint32_t *) ESP_RTC_USER_MEM_START)
@@ -34,6 +37,27 @@ static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 128;
 static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 64;
 #endif
 
+/* Layout of the preferences flash sector:
+ *
+ * - the full storage image, at the same place earlier versions stored it
+ * - one word with the CRC of the image
+ * - a log of records, each updating a range of the image: a header word, a CRC word and the new data
+ *
+ * A sync appends one record per changed range in a single flash write, the last one flagged as such. Only when the
+ * log is full, or could not be read back cleanly, the sector is erased and rewritten with the current image. At boot
+ * the image is loaded and the records of every complete sync are replayed on top of it, so an interrupted write
+ * leaves the preferences as they were before that sync.
+ */
+static const uint32_t ESP8266_FLASH_SECTOR_WORDS = SPI_FLASH_SEC_SIZE / 4;
+static const uint32_t ESP8266_FLASH_LOG_START = ESP8266_FLASH_STORAGE_SIZE + 1;
+static const uint32_t ESP8266_FLASH_IMAGE_MAGIC = 0x50524546;  // "PREF"
+static const uint32_t ESP8266_FLASH_RECORD_MAGIC = 0x5052;
+static const uint32_t ESP8266_FLASH_RECORD_LAST = 0x8000;
+static const uint32_t ESP8266_FLASH_EMPTY_WORD = 0xFFFFFFFF;
+
+// One bit per word of s_flash_storage that changed since the last sync
+static uint32_t s_flash_dirty_words[(ESP8266_FLASH_STORAGE_SIZE + 31) / 32];  // NOLINT
+
 static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
   if (index >= ESP_RTC_USER_MEM_SIZE_WORDS) {
     return false;
@@ -82,13 +106,57 @@ static bool save_to_flash(size_t offset, const uint32_t *data, size_t len) {
       return false;
     uint32_t v = data[i];
     uint32_t *ptr = &s_flash_storage[j];
-    if (*ptr != v)
+    if (*ptr != v) {
       s_flash_dirty = true;
+      s_flash_dirty_words[j / 32] |= 1UL << (j % 32);
+    }
     *ptr = v;
   }
   return true;
 }
 
+static bool is_flash_word_dirty(uint32_t index) { return s_flash_dirty_words[index / 32] & (1UL << (index % 32)); }
+
+static uint32_t make_record_header(uint32_t offset, uint32_t len, bool last) {
+  uint32_t magic = ESP8266_FLASH_RECORD_MAGIC | (last ? ESP8266_FLASH_RECORD_LAST : 0);
+  return (magic << 16) | (len << 8) | offset;
+}
+
+static bool read_flash_words(uint32_t offset, uint32_t *dest, uint32_t len) {
+  InterruptLock lock;
+  return spi_flash_read(get_esp8266_flash_address() + offset * 4, dest, len * 4) == SPI_FLASH_RESULT_OK;
+}
+
+/// Replay the records after the image, returns the end of the log or 0 if it does not end after a complete sync.
+static uint32_t replay_flash_log() {
+  // Records of a sync are only applied once its last record has been read back
+  std::vector<uint32_t> pending(s_flash_storage, s_flash_storage + ESP8266_FLASH_STORAGE_SIZE);
+  uint32_t pos = ESP8266_FLASH_LOG_START;
+  uint32_t committed = pos;
+  while (pos + 2 <= ESP8266_FLASH_SECTOR_WORDS) {
+    uint32_t header[2];
+    if (!read_flash_words(pos, header, 2))
+      return 0;
+    if (header[0] == ESP8266_FLASH_EMPTY_WORD)
+      break;
+    uint32_t offset = header[0] & 0xFF;
+    uint32_t len = (header[0] >> 8) & 0xFF;
+    uint32_t magic = header[0] >> 16;
+    if ((magic & ~ESP8266_FLASH_RECORD_LAST) != ESP8266_FLASH_RECORD_MAGIC || len == 0 ||
+        offset + len > ESP8266_FLASH_STORAGE_SIZE || pos + 2 + len > ESP8266_FLASH_SECTOR_WORDS)
+      return 0;
+    uint32_t *data = &pending[offset];
+    if (!read_flash_words(pos + 2, data, len) || calculate_crc(data, data + len, header[0]) != header[1])
+      return 0;
+    pos += 2 + len;
+    if (magic & ESP8266_FLASH_RECORD_LAST) {
+      memcpy(s_flash_storage, pending.data(), ESP8266_FLASH_STORAGE_SIZE * 4);
+      committed = pos;
+    }
+  }
+  return pos == committed ? pos : 0;
+}
+
 static bool load_from_flash(size_t offset, uint32_t *data, size_t len) {
   for (size_t i = 0; i < len; i++) {
     uint32_t j = offset + i;
@@ -171,10 +239,17 @@ class ESP8266Preferences : public ESPPreferences {
     s_flash_storage = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];  // NOLINT
     ESP_LOGVV(TAG, "Loading preferences from flash...");
 
-    {
-      InterruptLock lock;
-      spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+    uint32_t image_crc = 0;
+    read_flash_words(0, s_flash_storage, ESP8266_FLASH_STORAGE_SIZE);
+    read_flash_words(ESP8266_FLASH_STORAGE_SIZE, &image_crc, 1);
+    uint32_t *image_end = s_flash_storage + ESP8266_FLASH_STORAGE_SIZE;
+    if (image_crc != calculate_crc(s_flash_storage, image_end, ESP8266_FLASH_IMAGE_MAGIC)) {
+      // Written by an earlier version without the log: use the image as it is and rewrite it on the next sync
+      s_flash_log_end = 0;
+      return;
     }
+    s_flash_log_end = replay_flash_log();
+    ESP_LOGVV(TAG, "Preference log ends at word %u", s_flash_log_end);
   }
 
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
@@ -235,25 +310,39 @@ class ESP8266Preferences : public ESPPreferences {
     if (s_prevent_write)
       return false;
 
-    ESP_LOGD(TAG, "Saving preferences to flash...");
-    SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
-    {
-      InterruptLock lock;
-      erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
-      if (erase_res == SPI_FLASH_RESULT_OK) {
-        write_res = spi_flash_write(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+    // Find the runs of changed words, each becomes one record
+    std::vector<std::pair<uint32_t, uint32_t>> runs;
+    for (uint32_t i = 0; i < ESP8266_FLASH_STORAGE_SIZE; i++) {
+      if (!is_flash_word_dirty(i))
+        continue;
+      if (!runs.empty() && runs.back().second == i) {
+        runs.back().second++;
+      } else {
+        runs.emplace_back(i, i + 1);
       }
     }
-    if (erase_res != SPI_FLASH_RESULT_OK) {
-      ESP_LOGE(TAG, "Erase ESP8266 flash failed!");
-      return false;
+    std::vector<uint32_t> records;
+    for (size_t r = 0; r < runs.size(); r++) {
+      uint32_t start = runs[r].first, end = runs[r].second;
+      uint32_t header = make_record_header(start, end - start, r + 1 == runs.size());
+      records.push_back(header);
+      records.push_back(calculate_crc(s_flash_storage + start, s_flash_storage + end, header));
+      records.insert(records.end(), s_flash_storage + start, s_flash_storage + end);
     }
-    if (write_res != SPI_FLASH_RESULT_OK) {
-      ESP_LOGE(TAG, "Write ESP8266 flash failed!");
-      return false;
+
+    bool success;
+    if (s_flash_log_end != 0 && s_flash_log_end + records.size() <= ESP8266_FLASH_SECTOR_WORDS) {
+      ESP_LOGD(TAG, "Saving preferences to flash (%u bytes)...", records.size() * 4);
+      success = this->append_log_(records);
+    } else {
+      ESP_LOGD(TAG, "Saving preferences to flash, rewriting sector...");
+      success = this->rewrite_sector_();
     }
+    if (!success)
+      return false;
 
     s_flash_dirty = false;
+    memset(s_flash_dirty_words, 0, sizeof(s_flash_dirty_words));
     return true;
   }
 
@@ -273,6 +362,50 @@ class ESP8266Preferences : public ESPPreferences {
     s_prevent_write = true;
     return true;
   }
+
+ protected:
+  bool append_log_(std::vector<uint32_t> &records) {
+    SpiFlashOpResult write_res;
+    {
+      InterruptLock lock;
+      write_res = spi_flash_write(get_esp8266_flash_address() + s_flash_log_end * 4, records.data(),
+                                  records.size() * 4);
+    }
+    if (write_res != SPI_FLASH_RESULT_OK) {
+      ESP_LOGE(TAG, "Write ESP8266 flash failed!");
+      // The log might end in a partial record now
+      s_flash_log_end = 0;
+      return false;
+    }
+    s_flash_log_end += records.size();
+    return true;
+  }
+
+  bool rewrite_sector_() {
+    std::vector<uint32_t> image(s_flash_storage, s_flash_storage + ESP8266_FLASH_STORAGE_SIZE);
+    image.push_back(calculate_crc(image.begin(), image.end(), ESP8266_FLASH_IMAGE_MAGIC));
+
+    SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
+    {
+      InterruptLock lock;
+      erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
+      if (erase_res == SPI_FLASH_RESULT_OK) {
+        write_res = spi_flash_write(get_esp8266_flash_address(), image.data(), image.size() * 4);
+      }
+    }
+    if (erase_res != SPI_FLASH_RESULT_OK) {
+      ESP_LOGE(TAG, "Erase ESP8266 flash failed!");
+      s_flash_log_end = 0;
+      return false;
+    }
+    if (write_res != SPI_FLASH_RESULT_OK) {
+      ESP_LOGE(TAG, "Write ESP8266 flash failed!");
+      s_flash_log_end = 0;
+      return false;
+    }
+    s_flash_log_end = ESP8266_FLASH_LOG_START;
+    return true;
+  }
 };
 
 void setup_preferences() {
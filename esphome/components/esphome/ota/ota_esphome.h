@@ -23,6 +23,10 @@ class ESPHomeOTAComponent : public ota::OTAComponent {
   void dump_config() override;
   float get_setup_priority() const override;
   void loop() override;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// A connecting client makes the listening socket readable, which wakes the loop.
+  bool needs_polling() const override { return false; }
+#endif
 
   uint16_t get_port() const;
 
@@ -40,6 +40,7 @@ font_ns = cg.esphome_ns.namespace("font")
 Font = font_ns.class_("Font")
 Glyph = font_ns.class_("Glyph")
 GlyphData = font_ns.struct("GlyphData")
+GlyphRange = font_ns.struct("GlyphRange")
 
 CONF_BPP = "bpp"
 CONF_EXTRAS = "extras"
@@ -381,6 +382,7 @@ DEFAULT_GLYPHS = (
 )
 
 CONF_RAW_GLYPH_ID = "raw_glyph_id"
+CONF_RAW_RANGE_ID = "raw_range_id"
 
 FONT_SCHEMA = cv.Schema(
     {
@@ -403,6 +405,7 @@ FONT_SCHEMA = cv.Schema(
         ),
         cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         cv.GenerateID(CONF_RAW_GLYPH_ID): cv.declare_id(GlyphData),
+        cv.GenerateID(CONF_RAW_RANGE_ID): cv.declare_id(GlyphRange),
     },
 )
 
@@ -607,6 +610,26 @@ async def to_code(config):
 
     glyphs = cg.static_const_array(config[CONF_RAW_GLYPH_ID], glyph_initializer)
 
+    # Group the glyphs into runs of consecutive codepoints,
+    # so a glyph can be found without searching all glyphs.
+    runs = []
+    for index, codepoint in enumerate(codepoints):
+        point = ord(codepoint)
+        if runs and runs[-1][0] + runs[-1][1] == point:
+            runs[-1][1] += 1
+        else:
+            runs.append([point, 1, index])
+    range_initializer = [
+        cg.StructInitializer(
+            GlyphRange,
+            ("first_codepoint", first),
+            ("count", count),
+            ("first_glyph", index),
+        )
+        for first, count, index in runs
+    ]
+    ranges = cg.static_const_array(config[CONF_RAW_RANGE_ID], range_initializer)
+
     cg.new_Pvariable(
         config[CONF_ID],
         glyphs,
@@ -614,4 +637,6 @@ async def to_code(config):
         base_font.ascent,
         base_font.ascent + base_font.descent,
         bpp,
+        ranges,
+        len(range_initializer),
     )
@@ -45,13 +45,65 @@ void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
   *height = this->glyph_data_->height;
 }
 
-Font::Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp)
-    : baseline_(baseline), height_(height), bpp_(bpp) {
+Font::Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp, const GlyphRange *ranges,
+           int ranges_nr)
+    : ranges_(ranges), ranges_nr_(ranges_nr), baseline_(baseline), height_(height), bpp_(bpp) {
   glyphs_.reserve(data_nr);
   for (int i = 0; i < data_nr; ++i)
     glyphs_.emplace_back(&data[i]);
 }
+// Decode the UTF-8 sequence at str. Returns its length in bytes, or 0 if it is not valid.
+static int decode_utf8(const uint8_t *str, uint32_t *codepoint) {
+  int length;
+  if (str[0] < 0x80) {
+    *codepoint = str[0];
+    return 1;
+  } else if ((str[0] & 0xE0) == 0xC0) {
+    *codepoint = str[0] & 0x1F;
+    length = 2;
+  } else if ((str[0] & 0xF0) == 0xE0) {
+    *codepoint = str[0] & 0x0F;
+    length = 3;
+  } else if ((str[0] & 0xF8) == 0xF0) {
+    *codepoint = str[0] & 0x07;
+    length = 4;
+  } else {
+    return 0;
+  }
+  for (int i = 1; i != length; i++) {
+    // also stops at the terminating null byte
+    if ((str[i] & 0xC0) != 0x80)
+      return 0;
+    *codepoint = (*codepoint << 6) | (str[i] & 0x3F);
+  }
+  return length;
+}
+
 int Font::match_next_glyph(const uint8_t *str, int *match_length) {
+  if (this->ranges_ != nullptr) {
+    uint32_t codepoint;
+    *match_length = decode_utf8(str, &codepoint);
+    if (*match_length == 0)
+      return -1;
+    // find the last range starting at or before the codepoint, there are usually only a few
+    int lo = 0;
+    int hi = this->ranges_nr_;
+    while (lo != hi) {
+      int mid = (lo + hi) / 2;
+      if (this->ranges_[mid].first_codepoint <= codepoint) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    if (lo == 0)
+      return -1;
+    const GlyphRange &range = this->ranges_[lo - 1];
+    if (codepoint - range.first_codepoint >= range.count)
+      return -1;
+    return range.first_glyph + (codepoint - range.first_codepoint);
+  }
+
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -139,6 +191,9 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
     auto b_b = (float) background.b;
     auto b_w = (float) background.w;
     for (int glyph_y = y_start + scan_y1; glyph_y != max_y; glyph_y++) {
+      // runs of fully covered pixels are drawn as lines, which is much cheaper than drawing them one by one
+      int span_x = 0;
+      int span_width = 0;
       for (int glyph_x = x_at + scan_x1; glyph_x != max_x; glyph_x++) {
         uint8_t pixel = 0;
         for (int bit_num = 0; bit_num != this->bpp_; bit_num++) {
@@ -152,14 +207,23 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
           bitmask >>= 1;
         }
         if (pixel == bpp_max) {
-          display->draw_pixel_at(glyph_x, glyph_y, color);
-        } else if (pixel != 0) {
+          if (span_width++ == 0)
+            span_x = glyph_x;
+          continue;
+        }
+        if (span_width != 0) {
+          display->horizontal_line(span_x, glyph_y, span_width, color);
+          span_width = 0;
+        }
+        if (pixel != 0) {
           auto on = (float) pixel / (float) bpp_max;
           auto blended = Color((uint8_t) (diff_r * on + b_r), (uint8_t) (diff_g * on + b_g),
                                (uint8_t) (diff_b * on + b_b), (uint8_t) (diff_w * on + b_w));
           display->draw_pixel_at(glyph_x, glyph_y, blended);
         }
       }
+      if (span_width != 0)
+        display->horizontal_line(span_x, glyph_y, span_width, color);
     }
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
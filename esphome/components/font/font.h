@@ -21,6 +21,13 @@ struct GlyphData {
   int height;
 };
 
+/// A run of glyphs for consecutive codepoints, stored in the same order as the glyphs.
+struct GlyphRange {
+  uint32_t first_codepoint;
+  uint16_t count;
+  uint16_t first_glyph;
+};
+
 class Glyph {
  public:
   Glyph(const GlyphData *data) : glyph_data_(data) {}
@@ -52,8 +59,11 @@ class Font
    * @param glyphs A vector of glyphs, must be sorted lexicographically.
    * @param baseline The y-offset from the top of the text to the baseline.
    * @param bottom The y-offset from the top of the text to the bottom (i.e. height).
+   * @param ranges The runs of consecutive codepoints in glyphs, sorted by codepoint. Without them, glyphs are found
+   *     by a binary search over all glyphs.
    */
-  Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp = 1);
+  Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp = 1,
+       const GlyphRange *ranges = nullptr, int ranges_nr = 0);
 
   int match_next_glyph(const uint8_t *str, int *match_length);
 
@@ -70,6 +80,8 @@ class Font
 
  protected:
   std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_;
+  const GlyphRange *ranges_;
+  int ranges_nr_;
   int baseline_;
   int height_;
   uint8_t bpp_;  // bits per pixel
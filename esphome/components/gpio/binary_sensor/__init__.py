@@ -2,7 +2,9 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
 from esphome.components import binary_sensor
-from esphome.const import CONF_PIN
+from esphome.const import CONF_ESPHOME, CONF_PIN
+from esphome.core import CORE
+from esphome.core.config import CONF_LOOP_MODE, LOOP_MODE_EVENT_DRIVEN
 from .. import gpio_ns
 
 GPIOBinarySensor = gpio_ns.class_(
@@ -26,3 +28,10 @@ async def to_code(config):
 
     pin = await cg.gpio_pin_expression(config[CONF_PIN])
     cg.add(var.set_pin(pin))
+    if (
+        CORE.is_esp32
+        and CORE.config[CONF_ESPHOME][CONF_LOOP_MODE] == LOOP_MODE_EVENT_DRIVEN
+        and pins.PIN_SCHEMA_REGISTRY.get_key(config[CONF_PIN]) == CORE.target_platform
+    ):
+        # Internal pins can wake the event-driven loop from their edge interrupt
+        cg.add(var.set_use_interrupt(True))
@@ -1,6 +1,10 @@
 #include "gpio_binary_sensor.h"
 #include "esphome/core/log.h"
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+#include "esphome/core/application.h"
+#endif
+
 namespace esphome {
 namespace gpio {
 
@@ -9,8 +13,18 @@ static const char *const TAG = "gpio.binary_sensor";
 void GPIOBinarySensor::setup() {
   this->pin_->setup();
   this->publish_initial_state(this->pin_->digital_read());
+#ifdef USE_LOOP_EVENT_DRIVEN
+  if (this->use_interrupt_) {
+    static_cast<InternalGPIOPin *>(this->pin_)->attach_interrupt(&GPIOBinarySensor::gpio_intr, this,
+                                                                  gpio::INTERRUPT_ANY_EDGE);
+  }
+#endif
 }
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+void IRAM_ATTR GPIOBinarySensor::gpio_intr(GPIOBinarySensor *arg) { App.wake_loop_isrsafe(); }
+#endif
+
 void GPIOBinarySensor::dump_config() {
   LOG_BINARY_SENSOR("", "GPIO Binary Sensor", this);
   LOG_PIN("  Pin: ", this->pin_);
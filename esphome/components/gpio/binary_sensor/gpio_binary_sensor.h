@@ -10,6 +10,11 @@ namespace gpio {
 class GPIOBinarySensor : public binary_sensor::BinarySensor, public Component {
  public:
   void set_pin(GPIOPin *pin) { pin_ = pin; }
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// Wake the main loop from an edge interrupt instead of polling the pin, only valid for internal pins.
+  void set_use_interrupt(bool use_interrupt) { use_interrupt_ = use_interrupt; }
+  bool needs_polling() const override { return !this->use_interrupt_; }
+#endif
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Setup pin
@@ -22,6 +27,11 @@ class GPIOBinarySensor : public binary_sensor::BinarySensor, public Component {
 
  protected:
   GPIOPin *pin_;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  static void gpio_intr(GPIOBinarySensor *arg);
+
+  bool use_interrupt_{false};
+#endif
 };
 
 }  // namespace gpio
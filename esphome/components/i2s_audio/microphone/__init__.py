@@ -16,9 +16,11 @@ from .. import (
 
 CODEOWNERS = ["@jesserockz"]
 DEPENDENCIES = ["i2s_audio"]
+AUTO_LOAD = ["audio"]
 
 CONF_ADC_PIN = "adc_pin"
 CONF_ADC_TYPE = "adc_type"
+CONF_CORRECT_DC_OFFSET = "correct_dc_offset"
 CONF_PDM = "pdm"
 
 I2SAudioMicrophone = i2s_audio_ns.class_(
@@ -50,6 +52,10 @@ BASE_SCHEMA = microphone.MICROPHONE_SCHEMA.extend(
         default_channel=CONF_RIGHT,
         default_bits_per_sample="32bit",
     )
+).extend(
+    {
+        cv.Optional(CONF_CORRECT_DC_OFFSET, default=False): cv.boolean,
+    }
 ).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -80,6 +86,8 @@ async def to_code(config):
     await register_i2s_audio_component(var, config)
     await microphone.register_microphone(var, config)
 
+    cg.add(var.set_correct_dc_offset(config[CONF_CORRECT_DC_OFFSET]))
+
     if config[CONF_ADC_TYPE] == "internal":
         variant = esp32.get_esp32_variant()
         pin_num = config[CONF_ADC_PIN][CONF_NUMBER]
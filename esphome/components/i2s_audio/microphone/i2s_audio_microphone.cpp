@@ -4,13 +4,16 @@
 
 #include <driver/i2s.h>
 
+#include <algorithm>
+
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
 namespace i2s_audio {
 
-static const size_t BUFFER_SIZE = 512;
+// Samples read at a time, 16 ms at 16 kHz
+static const size_t BUFFER_SIZE = 256;
 
 static const char *const TAG = "i2s_audio.microphone";
 
@@ -45,6 +48,14 @@ void I2SAudioMicrophone::start_() {
   if (!this->parent_->try_lock()) {
     return;  // Waiting for another i2s to return lock
   }
+  // Allocate before installing the driver so a failure leaves nothing to tear down
+  if (this->audio_ring_.has_consumers() && !this->audio_ring_.allocate(AUDIO_RING_SAMPLES)) {
+    ESP_LOGE(TAG, "Could not allocate the audio buffer");
+    this->parent_->unlock();
+    this->state_ = microphone::STATE_STOPPED;
+    this->status_set_error();
+    return;
+  }
   i2s_driver_config_t config = {
       .mode = (i2s_mode_t) (this->i2s_mode_ | I2S_MODE_RX),
       .sample_rate = this->sample_rate_,
@@ -109,6 +120,7 @@ void I2SAudioMicrophone::start_() {
       return;
     }
   }
+  this->dc_offset_remover_.reset();
   this->state_ = microphone::STATE_RUNNING;
   this->high_freq_.start();
   this->status_clear_error();
@@ -149,51 +161,95 @@ void I2SAudioMicrophone::stop_() {
     return;
   }
   this->parent_->unlock();
+  // Free the shared buffer unless a consumer still reads, start_() allocates it again
+  if (!this->audio_ring_.has_active_consumers())
+    this->audio_ring_.deallocate();
   this->state_ = microphone::STATE_STOPPED;
   this->high_freq_.stop();
   this->status_clear_error();
 }
 
 size_t I2SAudioMicrophone::read(int16_t *buf, size_t len) {
+  return this->i2s_read_(buf, len, 100 / portTICK_PERIOD_MS);
+}
+
+size_t I2SAudioMicrophone::i2s_read_(int16_t *buf, size_t len, TickType_t ticks_to_wait) {
   size_t bytes_read = 0;
-  esp_err_t err = i2s_read(this->parent_->get_port(), buf, len, &bytes_read, (100 / portTICK_PERIOD_MS));
+  esp_err_t err = i2s_read(this->parent_->get_port(), buf, len, &bytes_read, ticks_to_wait);
   if (err != ESP_OK) {
     ESP_LOGW(TAG, "Error reading from I2S microphone: %s", esp_err_to_name(err));
     this->status_set_warning();
     return 0;
   }
   if (bytes_read == 0) {
-    this->status_set_warning();
+    // Nothing left without waiting is expected when draining, only a read that timed out is a problem
+    if (ticks_to_wait != 0)
+      this->status_set_warning();
     return 0;
   }
   this->status_clear_warning();
   // ESP-IDF I2S implementation right-extends 8-bit data to 16 bits,
   // and 24-bit data to 32 bits.
+  size_t samples_read;
   switch (this->bits_per_sample_) {
     case I2S_BITS_PER_SAMPLE_8BIT:
     case I2S_BITS_PER_SAMPLE_16BIT:
-      return bytes_read;
+      samples_read = bytes_read / sizeof(int16_t);
+      break;
     case I2S_BITS_PER_SAMPLE_24BIT:
-    case I2S_BITS_PER_SAMPLE_32BIT: {
-      size_t samples_read = bytes_read / sizeof(int32_t);
+    case I2S_BITS_PER_SAMPLE_32BIT:
+      samples_read = bytes_read / sizeof(int32_t);
       for (size_t i = 0; i < samples_read; i++) {
         int32_t temp = reinterpret_cast<int32_t *>(buf)[i] >> 14;
         buf[i] = clamp<int16_t>(temp, INT16_MIN, INT16_MAX);
       }
-      return samples_read * sizeof(int16_t);
-    }
+      break;
     default:
       ESP_LOGE(TAG, "Unsupported bits per sample: %d", this->bits_per_sample_);
       return 0;
   }
+  if (this->correct_dc_offset_)
+    this->dc_offset_remover_.process(buf, samples_read);
+  return samples_read * sizeof(int16_t);
 }
 
 void I2SAudioMicrophone::read_() {
-  std::vector<int16_t> samples;
-  samples.resize(BUFFER_SIZE);
-  size_t bytes_read = this->read(samples.data(), BUFFER_SIZE / sizeof(int16_t));
-  samples.resize(bytes_read / sizeof(int16_t));
-  this->data_callbacks_.call(samples);
+  // 24 and 32 bit samples arrive as 32 bit words and are only then converted to 16 bit, so reads are sized in words
+  const size_t bytes_per_sample =
+      this->bits_per_sample_ > I2S_BITS_PER_SAMPLE_16BIT ? sizeof(int32_t) : sizeof(int16_t);
+  TickType_t ticks_to_wait = 100 / portTICK_PERIOD_MS;
+  // Keep reading until the DMA buffers are empty, so samples don't pile up when the loop runs late
+  while (true) {
+    size_t samples = 0;
+    int16_t *region = this->audio_ring_.write_region(&samples);
+    samples = region == nullptr ? BUFFER_SIZE : std::min(samples, BUFFER_SIZE);
+    // 16 bit samples are read straight into the shared buffer, where all consumers find them. Wider samples don't fit
+    // there before conversion and go through the scratch buffer.
+    int16_t *buf = region;
+    if (region == nullptr || bytes_per_sample != sizeof(int16_t)) {
+      this->samples_.resize(samples * bytes_per_sample / sizeof(int16_t));
+      buf = this->samples_.data();
+    }
+    size_t samples_read = this->i2s_read_(buf, samples * bytes_per_sample, ticks_to_wait) / sizeof(int16_t);
+    ticks_to_wait = 0;
+    if (samples_read == 0)
+      return;
+    if (region != nullptr) {
+      if (buf != region)
+        std::copy(buf, buf + samples_read, region);
+      this->audio_ring_.commit(samples_read);
+    }
+    if (this->data_callbacks_.size() > 0) {
+      if (buf == region) {
+        this->samples_.assign(region, region + samples_read);
+      } else {
+        this->samples_.resize(samples_read);
+      }
+      this->data_callbacks_.call(this->samples_);
+    }
+    if (samples_read < samples)
+      return;
+  }
 }
 
 void I2SAudioMicrophone::loop() {
@@ -204,7 +260,7 @@ void I2SAudioMicrophone::loop() {
       this->start_();
       break;
     case microphone::STATE_RUNNING:
-      if (this->data_callbacks_.size() > 0) {
+      if (this->audio_ring_.has_active_consumers() || this->data_callbacks_.size() > 0) {
         this->read_();
       }
       break;
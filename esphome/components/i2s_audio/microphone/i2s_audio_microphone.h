@@ -4,6 +4,7 @@
 
 #include "../i2s_audio.h"
 
+#include "esphome/components/audio/audio_dsp.h"
 #include "esphome/components/microphone/microphone.h"
 #include "esphome/core/component.h"
 
@@ -20,6 +21,7 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
 
   void set_din_pin(int8_t pin) { this->din_pin_ = pin; }
   void set_pdm(bool pdm) { this->pdm_ = pdm; }
+  void set_correct_dc_offset(bool correct_dc_offset) { this->correct_dc_offset_ = correct_dc_offset; }
 
   size_t read(int16_t *buf, size_t len) override;
 
@@ -33,7 +35,10 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
  protected:
   void start_();
   void stop_();
+  /// Read the samples the DMA buffers hold into the shared buffer and pass them to the data callbacks.
   void read_();
+  /// Like read(), but waits at most ticks_to_wait for data.
+  size_t i2s_read_(int16_t *buf, size_t len, TickType_t ticks_to_wait);
 
   int8_t din_pin_{I2S_PIN_NO_CHANGE};
 #if SOC_I2S_SUPPORTS_ADC
@@ -41,6 +46,10 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
   bool adc_{false};
 #endif
   bool pdm_{false};
+  bool correct_dc_offset_{false};
+  audio::DCOffsetRemover dc_offset_remover_;
+  /// Samples for the data callbacks, kept to not allocate for every read.
+  std::vector<int16_t> samples_;
 
   HighFrequencyLoopRequester high_freq_;
 };
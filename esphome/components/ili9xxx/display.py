@@ -2,6 +2,8 @@ from esphome import core, pins
 import esphome.codegen as cg
 from esphome.components import display, spi
 from esphome.components.display import validate_rotation
+from esphome.components.esp32 import get_esp32_variant
+from esphome.components.esp32.const import VARIANT_ESP32, VARIANT_ESP32S3
 import esphome.config_validation as cv
 from esphome.const import (
     CONF_COLOR_ORDER,
@@ -22,11 +24,13 @@ from esphome.const import (
     CONF_RAW_DATA_ID,
     CONF_RESET_PIN,
     CONF_ROTATION,
+    CONF_SPI_ID,
     CONF_SWAP_XY,
     CONF_TRANSFORM,
     CONF_WIDTH,
 )
 from esphome.core import CORE, HexInt
+import esphome.final_validate as fv
 
 DEPENDENCIES = ["spi"]
 
@@ -90,6 +94,7 @@ CONF_LED_PIN = "led_pin"
 CONF_COLOR_PALETTE_IMAGES = "color_palette_images"
 CONF_INVERT_DISPLAY = "invert_display"
 CONF_PIXEL_MODE = "pixel_mode"
+CONF_DOUBLE_BUFFER = "double_buffer"
 
 
 def cmd(c, *args):
@@ -139,6 +144,14 @@ def _validate(config):
     ]:
         raise cv.Invalid("Selected model can't run on ESP8266.")
 
+    if config[CONF_DOUBLE_BUFFER] and (
+        not CORE.is_esp32 or get_esp32_variant() not in [VARIANT_ESP32, VARIANT_ESP32S3]
+    ):
+        raise cv.Invalid(
+            "Double buffering requires a dual-core ESP32 or ESP32-S3",
+            path=[CONF_DOUBLE_BUFFER],
+        )
+
     if model == "CUSTOM":
         if CONF_INIT_SEQUENCE not in config or CONF_DIMENSIONS not in config:
             raise cv.Invalid("CUSTOM model requires init_sequence and dimensions")
@@ -187,6 +200,7 @@ CONFIG_SCHEMA = cv.All(
                 }
             ),
             cv.Optional(CONF_INIT_SEQUENCE): cv.ensure_list(map_sequence),
+            cv.Optional(CONF_DOUBLE_BUFFER, default=False): cv.boolean,
         }
     )
     .extend(cv.polling_component_schema("1s"))
@@ -195,8 +209,37 @@ CONFIG_SCHEMA = cv.All(
     _validate,
 )
 
-FINAL_VALIDATE_SCHEMA = spi.final_validate_device_schema(
-    "ili9xxx", require_miso=False, require_mosi=True
+
+def _find_spi_devices(node, spi_id):
+    if isinstance(node, dict):
+        if node.get(CONF_SPI_ID) == spi_id:
+            yield node
+        for value in node.values():
+            yield from _find_spi_devices(value, spi_id)
+    elif isinstance(node, list):
+        for item in node:
+            yield from _find_spi_devices(item, spi_id)
+
+
+def _final_validate_double_buffer(config):
+    # The flush task drives the bus from the other core without any locking, so
+    # nothing else may use it in the meantime
+    if not config[CONF_DOUBLE_BUFFER]:
+        return config
+    for device in _find_spi_devices(fv.full_config.get(), config[CONF_SPI_ID]):
+        if device.get(CONF_ID) != config[CONF_ID]:
+            raise cv.Invalid(
+                f"{CONF_DOUBLE_BUFFER} requires the display to be the only device on "
+                f"its SPI bus, but '{device.get(CONF_ID)}' also uses "
+                f"'{config[CONF_SPI_ID]}'",
+                path=[CONF_DOUBLE_BUFFER],
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = cv.All(
+    spi.final_validate_device_schema("ili9xxx", require_miso=False, require_mosi=True),
+    _final_validate_double_buffer,
 )
 
 
@@ -214,6 +257,8 @@ async def to_code(config):
             sequence.extend(seq)
         cg.add(var.add_init_sequence(sequence))
 
+    if config[CONF_DOUBLE_BUFFER]:
+        cg.add(var.set_double_buffer(True))
     if pixel_mode := config.get(CONF_PIXEL_MODE):
         cg.add(var.set_pixel_mode(pixel_mode))
     if CONF_COLOR_ORDER in config:
@@ -4,6 +4,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace ili9xxx {
 
@@ -64,17 +66,37 @@ void ILI9XXXDisplay::setup() {
 }
 
 void ILI9XXXDisplay::alloc_buffer_() {
+  uint8_t bytes_per_pixel = 1;
   if (this->buffer_color_mode_ == BITS_16) {
     this->init_internal_(this->get_buffer_length_() * 2);
     if (this->buffer_ != nullptr) {
-      return;
+      bytes_per_pixel = 2;
+    } else {
+      this->buffer_color_mode_ = BITS_8;
     }
-    this->buffer_color_mode_ = BITS_8;
   }
-  this->init_internal_(this->get_buffer_length_());
   if (this->buffer_ == nullptr) {
-    this->mark_failed();
+    this->init_internal_(this->get_buffer_length_());
+    if (this->buffer_ == nullptr) {
+      this->mark_failed();
+      return;
+    }
   }
+  this->dirty_tiles_.init(this->width_, this->height_, bytes_per_pixel);
+#ifdef USE_ESP32
+  if (this->double_buffer_) {
+    ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+    this->front_buffer_ = allocator.allocate(this->get_buffer_length_() * bytes_per_pixel);
+    if (this->front_buffer_ == nullptr) {
+      ESP_LOGW(TAG, "Could not allocate second buffer, sending frames from the main loop");
+      this->double_buffer_ = false;
+      return;
+    }
+    // run on the core the main loop is not using
+    xTaskCreatePinnedToCore(ILI9XXXDisplay::flush_task, "ili9xxx_flush", 4096, this, 1, &this->flush_task_handle_,
+                            1 - xPortGetCoreID());
+  }
+#endif
 }
 
 void ILI9XXXDisplay::setup_pins_() {
@@ -109,6 +131,9 @@ void ILI9XXXDisplay::dump_config() {
     ESP_LOGCONFIG(TAG, "  18-Bit Mode: YES");
   }
   ESP_LOGCONFIG(TAG, "  Data rate: %dMHz", (unsigned) (this->data_rate_ / 1000000));
+#ifdef USE_ESP32
+  ESP_LOGCONFIG(TAG, "  Double buffer: %s", YESNO(this->double_buffer_));
+#endif
 
   LOG_PIN("  Reset Pin: ", this->reset_pin_);
   LOG_PIN("  CS Pin: ", this->cs_);
@@ -119,6 +144,10 @@ void ILI9XXXDisplay::dump_config() {
   ESP_LOGCONFIG(TAG, "  Mirror_x: %s", YESNO(this->mirror_x_));
   ESP_LOGCONFIG(TAG, "  Mirror_y: %s", YESNO(this->mirror_y_));
   ESP_LOGCONFIG(TAG, "  Invert colors: %s", YESNO(this->pre_invertcolors_));
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Frame Time", this->frame_time_sensor_);
+  LOG_SENSOR("  ", "Dropped Frames", this->dropped_frames_sensor_);
+#endif
 
   if (this->is_failed()) {
     ESP_LOGCONFIG(TAG, "  => Failed to init Memory: YES!");
@@ -208,6 +237,14 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
 }
 
 void ILI9XXXDisplay::update() {
+#ifdef USE_ESP32
+  if (this->flushing_) {
+    // the previous frame is still being sent, skip this one instead of blocking the main loop
+    this->dropped_frames_++;
+    this->publish_frame_stats_();
+    return;
+  }
+#endif
   if (this->prossing_update_) {
     this->need_update_ = true;
     return;
@@ -219,88 +256,179 @@ void ILI9XXXDisplay::update() {
   } while (this->need_update_);
   this->prossing_update_ = false;
   this->display_();
+  this->publish_frame_stats_();
 }
 
-void ILI9XXXDisplay::display_() {
-  // check if something was displayed
-  if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
-    return;
+void ILI9XXXDisplay::flush_changes_(const uint8_t *buffer, const std::vector<display::Rect> &changes) {
+  // Areas from the same tile band cover the same rows. Sent one by one as full-width rows, each of them would rewrite
+  // those rows, so collect the row ranges first and merge the overlapping ones.
+  auto &spans = this->row_spans_;
+  spans.clear();
+  for (auto &rect : changes) {
+    if (this->use_row_write_(rect.w, rect.h))
+      spans.emplace_back(rect.y, rect.y2());
   }
+  std::sort(spans.begin(), spans.end());
+  size_t merged = 0;
+  for (auto &span : spans) {
+    if (merged != 0 && span.first <= spans[merged - 1].second) {
+      spans[merged - 1].second = std::max(spans[merged - 1].second, span.second);
+    } else {
+      spans[merged++] = span;
+    }
+  }
+  spans.resize(merged);
+
+  for (auto &span : spans)
+    this->flush_rows_(buffer, span.first, span.second - 1);
+  for (auto &rect : changes) {
+    // skip areas whose rows were already sent in full
+    bool covered = std::any_of(spans.begin(), spans.end(), [&rect](const std::pair<int16_t, int16_t> &span) {
+      return span.first <= rect.y && rect.y2() <= span.second;
+    });
+    if (!covered)
+      this->flush_rect_(buffer, rect.x, rect.y, rect.x2() - 1, rect.y2() - 1);
+  }
+}
 
-  // we will only update the changed rows to the display
-  size_t const w = this->x_high_ - this->x_low_ + 1;
-  size_t const h = this->y_high_ - this->y_low_ + 1;
-
+bool ILI9XXXDisplay::use_row_write_(size_t w, size_t h) const {
+  // only 16 bit mode maps directly to the display format
+  if (this->buffer_color_mode_ != BITS_16 || this->is_18bitdisplay_)
+    return false;
   size_t mhz = this->data_rate_ / 1000000;
   // estimate time for a single write
   size_t sw_time = this->width_ * h * 16 / mhz + this->width_ * h * 2 / SPI_MAX_BLOCK_SIZE * SPI_SETUP_US * 2;
   // estimate time for multiple writes
   size_t mw_time = (w * h * 16) / mhz + w * h * 2 / ILI9XXX_TRANSFER_BUFFER_SIZE * SPI_SETUP_US;
+  ESP_LOGV(TAG, "Estimated write of %zux%zu: sw_time=%zuus, mw_time=%zuus", w, h, sw_time, mw_time);
+  return sw_time < mw_time;
+}
+
+void ILI9XXXDisplay::flush_rows_(const uint8_t *buffer, uint16_t y_low, uint16_t y_high) {
+  size_t const h = y_high - y_low + 1;
+  ESP_LOGV(TAG, "Doing single write of %zu bytes", this->width_ * h * 2);
+  this->set_addr_window_(0, y_low, this->width_ - 1, y_high);
+  this->write_array(buffer + y_low * this->width_ * 2, h * this->width_ * 2);
+  this->end_data_();
+}
+
+void ILI9XXXDisplay::flush_rect_(const uint8_t *buffer, uint16_t x_low, uint16_t y_low, uint16_t x_high,
+                                 uint16_t y_high) {
+  // we will only update the changed rows to the display
+  size_t const w = x_high - x_low + 1;
+  size_t const h = y_high - y_low + 1;
+
   ESP_LOGV(TAG,
-           "Start display(xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%d, "
-           "height:%zu, mode=%d, 18bit=%d, sw_time=%zuus, mw_time=%zuus)",
-           this->x_low_, this->y_low_, this->x_high_, this->y_high_, w, h, this->buffer_color_mode_,
-           this->is_18bitdisplay_, sw_time, mw_time);
-  auto now = millis();
-  if (this->buffer_color_mode_ == BITS_16 && !this->is_18bitdisplay_ && sw_time < mw_time) {
-    // 16 bit mode maps directly to display format
-    ESP_LOGV(TAG, "Doing single write of %zu bytes", this->width_ * h * 2);
-    set_addr_window_(0, this->y_low_, this->width_ - 1, this->y_high_);
-    this->write_array(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
-  } else {
-    ESP_LOGV(TAG, "Doing multiple write");
-    uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
-    size_t rem = h * w;  // remaining number of pixels to write
-    set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
-    size_t idx = 0;    // index into transfer_buffer
-    size_t pixel = 0;  // pixel number offset
-    size_t pos = this->y_low_ * this->width_ + this->x_low_;
-    while (rem-- != 0) {
-      uint16_t color_val;
-      switch (this->buffer_color_mode_) {
-        case BITS_8:
-          color_val = display::ColorUtil::color_to_565(display::ColorUtil::rgb332_to_color(this->buffer_[pos++]));
-          break;
-        case BITS_8_INDEXED:
-          color_val = display::ColorUtil::color_to_565(
-              display::ColorUtil::index8_to_color_palette888(this->buffer_[pos++], this->palette_));
-          break;
-        default:  // case BITS_16:
-          color_val = (this->buffer_[pos * 2] << 8) + this->buffer_[pos * 2 + 1];
-          pos++;
-          break;
-      }
-      if (this->is_18bitdisplay_) {
-        transfer_buffer[idx++] = (uint8_t) ((color_val & 0xF800) >> 8);  // Blue
-        transfer_buffer[idx++] = (uint8_t) ((color_val & 0x7E0) >> 3);   // Green
-        transfer_buffer[idx++] = (uint8_t) (color_val << 3);             // Red
-      } else {
-        put16_be(transfer_buffer + idx, color_val);
-        idx += 2;
-      }
-      if (idx == sizeof(transfer_buffer)) {
-        this->write_array(transfer_buffer, idx);
-        idx = 0;
-        App.feed_wdt();
-      }
-      // end of line? Skip to the next.
-      if (++pixel == w) {
-        pixel = 0;
-        pos += this->width_ - w;
-      }
+           "Doing multiple write (xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%zu, "
+           "height:%zu, mode=%d, 18bit=%d)",
+           x_low, y_low, x_high, y_high, w, h, this->buffer_color_mode_, this->is_18bitdisplay_);
+  uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
+  size_t rem = h * w;  // remaining number of pixels to write
+  this->set_addr_window_(x_low, y_low, x_high, y_high);
+  size_t idx = 0;    // index into transfer_buffer
+  size_t pixel = 0;  // pixel number offset
+  size_t pos = y_low * this->width_ + x_low;
+  while (rem-- != 0) {
+    uint16_t color_val;
+    switch (this->buffer_color_mode_) {
+      case BITS_8:
+        color_val = display::ColorUtil::color_to_565(display::ColorUtil::rgb332_to_color(buffer[pos++]));
+        break;
+      case BITS_8_INDEXED:
+        color_val = display::ColorUtil::color_to_565(
+            display::ColorUtil::index8_to_color_palette888(buffer[pos++], this->palette_));
+        break;
+      default:  // case BITS_16:
+        color_val = (buffer[pos * 2] << 8) + buffer[pos * 2 + 1];
+        pos++;
+        break;
     }
-    // flush any balance.
-    if (idx != 0) {
+    if (this->is_18bitdisplay_) {
+      transfer_buffer[idx++] = (uint8_t) ((color_val & 0xF800) >> 8);  // Blue
+      transfer_buffer[idx++] = (uint8_t) ((color_val & 0x7E0) >> 3);   // Green
+      transfer_buffer[idx++] = (uint8_t) (color_val << 3);             // Red
+    } else {
+      put16_be(transfer_buffer + idx, color_val);
+      idx += 2;
+    }
+    if (idx == sizeof(transfer_buffer)) {
       this->write_array(transfer_buffer, idx);
+      idx = 0;
+      // the flush task is not watched by the task watchdog
+      if (buffer == this->buffer_)
+        App.feed_wdt();
+    }
+    // end of line? Skip to the next.
+    if (++pixel == w) {
+      pixel = 0;
+      pos += this->width_ - w;
     }
   }
+  // flush any balance.
+  if (idx != 0) {
+    this->write_array(transfer_buffer, idx);
+  }
   this->end_data_();
-  ESP_LOGV(TAG, "Data write took %dms", (unsigned) (millis() - now));
+}
+
+void ILI9XXXDisplay::display_() {
+  // check if something was displayed
+  if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
+    return;
+  }
+
+  // only send the parts of the changed area that differ from what is already on the display
+  display::Rect region(this->x_low_, this->y_low_, this->x_high_ - this->x_low_ + 1, this->y_high_ - this->y_low_ + 1);
+  auto &changes = this->dirty_tiles_.find_changes(this->buffer_, region);
   // invalidate watermarks
   this->x_low_ = this->width_;
   this->y_low_ = this->height_;
   this->x_high_ = 0;
   this->y_high_ = 0;
+  if (changes.empty())
+    return;
+
+#ifdef USE_ESP32
+  if (this->front_buffer_ != nullptr) {
+    // hand the changed rows over to the flush task, and keep drawing into buffer_ while it sends them
+    size_t stride = this->width_ * (this->buffer_color_mode_ == BITS_16 ? 2 : 1);
+    for (auto &rect : changes)
+      memcpy(this->front_buffer_ + rect.y * stride, this->buffer_ + rect.y * stride, rect.h * stride);
+    this->flush_rects_ = changes;
+    this->flushing_ = true;
+    xTaskNotifyGive(this->flush_task_handle_);
+    return;
+  }
+#endif
+
+  auto now = millis();
+  this->flush_changes_(this->buffer_, changes);
+  this->frame_time_ = millis() - now;
+  this->frame_done_ = true;
+  ESP_LOGV(TAG, "Data write took %ums", (unsigned) this->frame_time_);
+}
+
+#ifdef USE_ESP32
+void ILI9XXXDisplay::flush_task(void *params) {
+  auto *display = reinterpret_cast<ILI9XXXDisplay *>(params);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    auto now = millis();
+    display->flush_changes_(display->front_buffer_, display->flush_rects_);
+    display->frame_time_ = millis() - now;
+    display->frame_done_ = true;
+    display->flushing_ = false;
+  }
+}
+#endif
+
+void ILI9XXXDisplay::publish_frame_stats_() {
+#ifdef USE_SENSOR
+  if (this->frame_time_sensor_ != nullptr && this->frame_done_.exchange(false))
+    this->frame_time_sensor_->publish_state(this->frame_time_);
+  if (this->dropped_frames_sensor_ != nullptr && this->dropped_frames_sensor_->get_raw_state() != this->dropped_frames_)
+    this->dropped_frames_sensor_->publish_state(this->dropped_frames_);
+#endif
 }
 
 // note that this bypasses the buffer and writes directly to the display.
@@ -312,11 +440,19 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
   // if color mapping or software rotation is required, hand this off to the parent implementation. This will
   // do color conversion pixel-by-pixel into the buffer and draw it later. If this is happening the user has not
   // configured the renderer well.
-  if (this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES || bitness != display::COLOR_BITNESS_565 || !big_endian) {
-    display::Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset,
-                                     x_pad);
+  bool use_buffer =
+      this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES || bitness != display::COLOR_BITNESS_565 || !big_endian;
+#ifdef USE_ESP32
+  // the flush task may be using the bus, so go through the buffer as well
+  use_buffer |= this->double_buffer_;
+#endif
+  if (use_buffer) {
+    display::DisplayBuffer::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset,
+                                           y_offset, x_pad);
     return;
   }
+  // the buffer no longer matches what is shown here, so make sure the next buffer flush covers this area
+  this->dirty_tiles_.invalidate(display::Rect(x_start, y_start, w, h));
   this->set_addr_window_(x_start, y_start, x_start + w - 1, y_start + h - 1);
   // x_ and y_offset are offsets into the source buffer, unrelated to our own offsets into the display.
   auto stride = x_offset + w + x_pad;
@@ -1,10 +1,23 @@
 #pragma once
+#include "esphome/core/defines.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
 #include "esphome/components/display/display_color_utils.h"
+#include "esphome/components/display/dirty_tiles.h"
 #include "ili9xxx_defines.h"
 #include "ili9xxx_init.h"
 
+#include <atomic>
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 namespace ili9xxx {
 
@@ -82,6 +95,16 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   void set_mirror_x(bool mirror_x) { this->mirror_x_ = mirror_x; }
   void set_mirror_y(bool mirror_y) { this->mirror_y_ = mirror_y; }
   void set_pixel_mode(PixelMode mode) { this->pixel_mode_ = mode; }
+#ifdef USE_ESP32
+  /// Send frames from a task on the other core while the next frame is drawn.
+  void set_double_buffer(bool double_buffer) { this->double_buffer_ = double_buffer; }
+#endif
+#ifdef USE_SENSOR
+  void set_frame_time_sensor(sensor::Sensor *frame_time_sensor) { this->frame_time_sensor_ = frame_time_sensor; }
+  void set_dropped_frames_sensor(sensor::Sensor *dropped_frames_sensor) {
+    this->dropped_frames_sensor_ = dropped_frames_sensor;
+  }
+#endif
 
   void update() override;
 
@@ -109,6 +132,16 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
 
   virtual void set_madctl();
   void display_();
+  /// Send the changed areas of buffer, writing rows that several areas share only once.
+  void flush_changes_(const uint8_t *buffer, const std::vector<display::Rect> &changes);
+  /// Whether sending a w x h area is faster as full-width rows straight from the buffer than converted per pixel.
+  bool use_row_write_(size_t w, size_t h) const;
+  void flush_rows_(const uint8_t *buffer, uint16_t y_low, uint16_t y_high);
+  void flush_rect_(const uint8_t *buffer, uint16_t x_low, uint16_t y_low, uint16_t x_high, uint16_t y_high);
+  void publish_frame_stats_();
+#ifdef USE_ESP32
+  static void flush_task(void *params);
+#endif
   void init_lcd_(const uint8_t *addr);
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t x2, uint16_t y2);
   void reset_();
@@ -124,6 +157,30 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   uint16_t x_high_{0};
   uint16_t y_high_{0};
   const uint8_t *palette_{};
+  display::DirtyTiles dirty_tiles_;
+  /// Row ranges [first, second) sent as full-width rows by flush_changes_(), kept to avoid reallocating.
+  std::vector<std::pair<int16_t, int16_t>> row_spans_;
+
+  /// Time taken to send the last frame to the display, in milliseconds.
+  std::atomic<uint32_t> frame_time_{0};
+  /// Set when a frame has been sent since the frame time was last published.
+  std::atomic<bool> frame_done_{false};
+  /// Number of updates skipped because the previous frame was still being sent.
+  uint32_t dropped_frames_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *frame_time_sensor_{nullptr};
+  sensor::Sensor *dropped_frames_sensor_{nullptr};
+#endif
+#ifdef USE_ESP32
+  bool double_buffer_{false};
+  /// Copy of the changed rows of buffer_ that the flush task sends, nullptr unless double buffering.
+  uint8_t *front_buffer_{nullptr};
+  /// Areas of front_buffer_ for the flush task to send.
+  std::vector<display::Rect> flush_rects_;
+  /// Set while the flush task is sending a frame; front_buffer_ and flush_rects_ belong to the task until cleared.
+  std::atomic<bool> flushing_{false};
+  TaskHandle_t flush_task_handle_{nullptr};
+#endif
 
   ILI9XXXColorMode buffer_color_mode_{BITS_16};
 
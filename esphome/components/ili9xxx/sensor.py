@@ -0,0 +1,46 @@
+import esphome.codegen as cg
+from esphome.components import sensor
+import esphome.config_validation as cv
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
+)
+
+from .display import ILI9XXXDisplay
+
+DEPENDENCIES = ["ili9xxx"]
+
+CONF_ILI9XXX_ID = "ili9xxx_id"
+CONF_FRAME_TIME = "frame_time"
+CONF_DROPPED_FRAMES = "dropped_frames"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_ILI9XXX_ID): cv.use_id(ILI9XXXDisplay),
+        cv.Optional(CONF_FRAME_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_DROPPED_FRAMES): sensor.sensor_schema(
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_ILI9XXX_ID])
+    if frame_time_config := config.get(CONF_FRAME_TIME):
+        sens = await sensor.new_sensor(frame_time_config)
+        cg.add(parent.set_frame_time_sensor(sens))
+    if dropped_frames_config := config.get(CONF_DROPPED_FRAMES):
+        sens = await sensor.new_sensor(dropped_frames_config)
+        cg.add(parent.set_dropped_frames_sensor(sens))
@@ -1,63 +1,175 @@
 #include "image.h"
 
+#include <algorithm>
+
 #include "esphome/core/hal.h"
 
 namespace esphome {
 namespace image {
 
+static const int BLIT_CHUNK_PIXELS = 64;
+
+// Pixel readers for Image::draw(). Each converts one source pixel to the display format given by BITNESS and returns
+// its alpha, 0 for transparent pixels.
+struct GrayscaleReader {
+  static constexpr display::ColorBitness BITNESS = display::COLOR_BITNESS_888;
+  bool transparent;
+  uint8_t source_bytes() const { return 1; }
+  uint8_t read(const uint8_t *src, uint8_t *dst) const {
+    uint8_t gray = progmem_read_byte(src);
+    if (gray == 1 && this->transparent)
+      return 0;
+    dst[0] = dst[1] = dst[2] = gray;
+    return 0xFF;
+  }
+};
+struct RGB24Reader {
+  static constexpr display::ColorBitness BITNESS = display::COLOR_BITNESS_888;
+  bool transparent;
+  uint8_t source_bytes() const { return 3; }
+  uint8_t read(const uint8_t *src, uint8_t *dst) const {
+    dst[0] = progmem_read_byte(src);
+    dst[1] = progmem_read_byte(src + 1);
+    dst[2] = progmem_read_byte(src + 2);
+    // (0, 0, 1) has been defined as transparent color for non-alpha images.
+    return dst[2] == 1 && dst[0] == 0 && dst[1] == 0 && this->transparent ? 0 : 0xFF;
+  }
+};
+struct RGBAReader {
+  static constexpr display::ColorBitness BITNESS = display::COLOR_BITNESS_888;
+  uint8_t source_bytes() const { return 4; }
+  uint8_t read(const uint8_t *src, uint8_t *dst) const {
+    dst[0] = progmem_read_byte(src);
+    dst[1] = progmem_read_byte(src + 1);
+    dst[2] = progmem_read_byte(src + 2);
+    return progmem_read_byte(src + 3);
+  }
+};
+struct RGB565Reader {
+  static constexpr display::ColorBitness BITNESS = display::COLOR_BITNESS_565;
+  bool transparent;
+  uint8_t source_bytes() const { return this->transparent ? 3 : 2; }
+  uint8_t read(const uint8_t *src, uint8_t *dst) const {
+    dst[0] = progmem_read_byte(src);
+    dst[1] = progmem_read_byte(src + 1);
+    return this->transparent ? progmem_read_byte(src + 2) : 0xFF;
+  }
+};
+
+// Convert the area of the image row by row and hand the runs of opaque pixels to the display in chunks.
+// draw_pixels_at() can't carry alpha, so partially transparent pixels are drawn one by one with their alpha as before.
+template<typename Reader>
+static void blit_rows(display::Display *display, int x, int y, const Image *image, const uint8_t *data, int width,
+                      const display::Rect &area, Reader reader) {
+  const size_t dst_bytes = Reader::BITNESS == display::COLOR_BITNESS_565 ? 2 : 3;
+  uint8_t buffer[BLIT_CHUNK_PIXELS * 3];
+  for (int img_y = area.y; img_y != area.y2(); img_y++) {
+    const uint8_t *src = data + (img_y * width + area.x) * reader.source_bytes();
+    int span_x = 0;
+    int count = 0;
+    for (int img_x = area.x; img_x != area.x2(); img_x++, src += reader.source_bytes()) {
+      uint8_t alpha = reader.read(src, buffer + count * dst_bytes);
+      if (alpha == 0xFF) {
+        if (count++ == 0)
+          span_x = img_x;
+        if (count != BLIT_CHUNK_PIXELS)
+          continue;
+      }
+      if (count != 0) {
+        display->draw_pixels_at(x + span_x, y + img_y, count, 1, buffer, display::COLOR_ORDER_RGB, Reader::BITNESS,
+                                true, 0, 0, 0);
+        count = 0;
+      }
+      if (alpha >= 0x80 && alpha != 0xFF)
+        display->draw_pixel_at(x + img_x, y + img_y, image->get_pixel(img_x, img_y));
+    }
+    if (count != 0) {
+      display->draw_pixels_at(x + span_x, y + img_y, count, 1, buffer, display::COLOR_ORDER_RGB, Reader::BITNESS, true,
+                              0, 0, 0);
+    }
+  }
+}
+
 void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
-  switch (type_) {
-    case IMAGE_TYPE_BINARY: {
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          if (this->get_binary_pixel_(img_x, img_y)) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_on);
-          } else if (!this->transparent_) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_off);
-          }
+  // clip once against the display and its clipping region, in image coordinates
+  int x1 = std::max(0, -x);
+  int x2 = std::min(this->width_, display->get_width() - x);
+  int y1 = std::max(0, -y);
+  int y2 = std::min(this->height_, display->get_height() - y);
+  auto clipping = display->get_clipping();
+  if (clipping.is_set()) {
+    // like Rect::inside(), which draw_pixel_at() uses, the right and bottom edges are part of the clipping region
+    x1 = std::max(x1, clipping.x - x);
+    x2 = std::min(x2, clipping.x2() + 1 - x);
+    y1 = std::max(y1, clipping.y - y);
+    y2 = std::min(y2, clipping.y2() + 1 - y);
+  }
+  if (x1 >= x2 || y1 >= y2)
+    return;
+  display::Rect area(x1, y1, x2 - x1, y2 - y1);
+
+  if (this->type_ == IMAGE_TYPE_BINARY) {
+    // draw runs of equal pixels as lines
+    for (int img_y = y1; img_y != y2; img_y++) {
+      int span_x = x1;
+      bool span_on = this->get_binary_pixel_(x1, img_y);
+      for (int img_x = x1 + 1; img_x <= x2; img_x++) {
+        bool on = img_x != x2 && this->get_binary_pixel_(img_x, img_y);
+        if (img_x != x2 && on == span_on)
+          continue;
+        if (span_on) {
+          display->horizontal_line(x + span_x, y + img_y, img_x - span_x, color_on);
+        } else if (!this->transparent_) {
+          display->horizontal_line(x + span_x, y + img_y, img_x - span_x, color_off);
         }
+        span_x = img_x;
+        span_on = on;
       }
-      break;
     }
-    case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_grayscale_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
+    return;
+  }
+
+  if (display->get_display_type() != display::DISPLAY_TYPE_COLOR) {
+    // leave the conversion of colors to the display
+    for (int img_y = y1; img_y != y2; img_y++) {
+      for (int img_x = x1; img_x != x2; img_x++) {
+        auto color = this->get_pixel(img_x, img_y);
+        if (color.w >= 0x80)
+          display->draw_pixel_at(x + img_x, y + img_y, color);
       }
+    }
+    return;
+  }
+
+  switch (this->type_) {
+    case IMAGE_TYPE_GRAYSCALE:
+      blit_rows(display, x, y, this, this->data_start_, this->width_, area, GrayscaleReader{this->transparent_});
       break;
-    case IMAGE_TYPE_RGB565:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb565_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
+    case IMAGE_TYPE_RGB24:
+#ifndef USE_ESP8266
+      if (!this->transparent_) {
+        // already in a format the display accepts, hand over the whole area
+        display->draw_pixels_at(x + x1, y + y1, area.w, area.h, this->data_start_, display::COLOR_ORDER_RGB,
+                                display::COLOR_BITNESS_888, true, x1, y1, this->width_ - x2);
+        break;
       }
+#endif
+      blit_rows(display, x, y, this, this->data_start_, this->width_, area, RGB24Reader{this->transparent_});
       break;
-    case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb24_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
+    case IMAGE_TYPE_RGB565:
+#ifndef USE_ESP8266
+      if (!this->transparent_) {
+        display->draw_pixels_at(x + x1, y + y1, area.w, area.h, this->data_start_, display::COLOR_ORDER_RGB,
+                                display::COLOR_BITNESS_565, true, x1, y1, this->width_ - x2);
+        break;
       }
+#endif
+      blit_rows(display, x, y, this, this->data_start_, this->width_, area, RGB565Reader{this->transparent_});
       break;
     case IMAGE_TYPE_RGBA:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgba_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+      blit_rows(display, x, y, this, this->data_start_, this->width_, area, RGBAReader{});
+      break;
+    default:
       break;
   }
 }
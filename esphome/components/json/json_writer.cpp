@@ -0,0 +1,117 @@
+#include "json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace json {
+
+void JsonWriter::add(const char *key, const char *prefix, const std::string &value) {
+  this->key_(key);
+  this->output_.push_back('"');
+  this->string_chars_(prefix, strlen(prefix));
+  this->string_chars_(value.data(), value.size());
+  this->output_.push_back('"');
+}
+
+void JsonWriter::begin_(char c) {
+  this->output_.push_back(c);
+  this->first_ = true;
+}
+
+void JsonWriter::end_(char c) {
+  this->output_.push_back(c);
+  this->first_ = false;
+}
+
+void JsonWriter::separator_() {
+  if (!this->first_)
+    this->output_.push_back(',');
+  this->first_ = false;
+}
+
+void JsonWriter::key_(const char *key) {
+  this->separator_();
+  this->string_(key);
+  this->output_.push_back(':');
+}
+
+void JsonWriter::string_(const char *value) {
+  if (value == nullptr) {
+    this->output_.append("null");
+    return;
+  }
+  this->string_(value, strlen(value));
+}
+
+void JsonWriter::string_(const char *value, size_t length) {
+  this->output_.push_back('"');
+  this->string_chars_(value, length);
+  this->output_.push_back('"');
+}
+
+void JsonWriter::string_chars_(const char *value, size_t length) {
+  static const char *const HEX_DIGITS = "0123456789abcdef";
+  size_t start = 0;
+  for (size_t i = 0; i < length; i++) {
+    const uint8_t c = value[i];
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+    // Copy the characters that need no escaping in one go
+    this->output_.append(value + start, i - start);
+    start = i + 1;
+    this->output_.push_back('\\');
+    switch (c) {
+      case '"':
+      case '\\':
+        this->output_.push_back(c);
+        break;
+      case '\b':
+        this->output_.push_back('b');
+        break;
+      case '\f':
+        this->output_.push_back('f');
+        break;
+      case '\n':
+        this->output_.push_back('n');
+        break;
+      case '\r':
+        this->output_.push_back('r');
+        break;
+      case '\t':
+        this->output_.push_back('t');
+        break;
+      default:
+        this->output_.append("u00");
+        this->output_.push_back(HEX_DIGITS[c >> 4]);
+        this->output_.push_back(HEX_DIGITS[c & 0x0F]);
+        break;
+    }
+  }
+  this->output_.append(value + start, length - start);
+}
+
+void JsonWriter::integer_(uint64_t value) {
+  char buf[20];
+  size_t pos = sizeof(buf);
+  do {
+    buf[--pos] = '0' + value % 10;
+    value /= 10;
+  } while (value != 0);
+  this->output_.append(buf + pos, sizeof(buf) - pos);
+}
+
+void JsonWriter::float_(float value) {
+  if (!std::isfinite(value)) {
+    this->output_.append("null");
+    return;
+  }
+  // Nine significant digits are enough to read back the same float
+  char buf[24];
+  int len = snprintf(buf, sizeof(buf), "%.9g", value);
+  this->output_.append(buf, len);
+}
+
+}  // namespace json
+}  // namespace esphome
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "esphome/core/string_ref.h"
+
+namespace esphome {
+namespace json {
+
+/** Writes JSON text straight into a string, without building a document first.
+ *
+ * Unlike build_json(), nothing has to be sized up front: keys and values are appended to the output in the order they
+ * are added, and the string only grows as much as the text needs. Used for messages whose layout is known, like the
+ * entity states of the web server.
+ *
+ * The writer does not check the structure, every begin_*() call must be matched by the corresponding end_*() call.
+ */
+class JsonWriter {
+ public:
+  /// Write to output, replacing its contents. Reserving capacity in output beforehand avoids growing it.
+  explicit JsonWriter(std::string &output) : output_(output) { this->output_.clear(); }
+
+  void begin_object() { this->begin_('{'); }
+  void begin_object(const char *key) {
+    this->key_(key);
+    this->begin_('{');
+  }
+  void end_object() { this->end_('}'); }
+  void begin_array(const char *key) {
+    this->key_(key);
+    this->begin_('[');
+  }
+  void end_array() { this->end_(']'); }
+
+  void add(const char *key, const char *value) {
+    this->key_(key);
+    this->string_(value);
+  }
+  void add(const char *key, const std::string &value) {
+    this->key_(key);
+    this->string_(value.data(), value.size());
+  }
+  void add(const char *key, const StringRef &value) {
+    this->key_(key);
+    this->string_(value.c_str(), value.size());
+  }
+  /// Add a string value made of prefix followed by value, without concatenating them first.
+  void add(const char *key, const char *prefix, const std::string &value);
+  void add(const char *key, bool value) {
+    this->key_(key);
+    this->output_.append(value ? "true" : "false");
+  }
+  /// Add a number, or null if value is NaN or infinite.
+  void add(const char *key, float value) {
+    this->key_(key);
+    this->float_(value);
+  }
+  template<typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+  void add(const char *key, T value) {
+    this->key_(key);
+    if (std::is_signed<T>::value && value < 0) {
+      this->output_.push_back('-');
+      this->integer_(static_cast<uint64_t>(0) - static_cast<uint64_t>(value));
+    } else {
+      this->integer_(static_cast<uint64_t>(value));
+    }
+  }
+
+  /// Add a string to the current array.
+  void add_item(const char *value) {
+    this->separator_();
+    this->string_(value);
+  }
+  void add_item(const std::string &value) {
+    this->separator_();
+    this->string_(value.data(), value.size());
+  }
+
+ protected:
+  void begin_(char c);
+  void end_(char c);
+  void separator_();
+  void key_(const char *key);
+  void string_(const char *value);
+  void string_(const char *value, size_t length);
+  void string_chars_(const char *value, size_t length);
+  void integer_(uint64_t value);
+  void float_(float value);
+
+  std::string &output_;
+  /// Whether the next value is the first one of the current object or array.
+  bool first_{true};
+};
+
+}  // namespace json
+}  // namespace esphome
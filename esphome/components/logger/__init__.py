@@ -19,6 +19,7 @@ import esphome.config_validation as cv
 from esphome.const import (
     CONF_ARGS,
     CONF_BAUD_RATE,
+    CONF_BUFFER_SIZE,
     CONF_DEASSERT_RTS_DTR,
     CONF_FORMAT,
     CONF_HARDWARE_UART,
@@ -170,6 +171,7 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_BINARY_LOG = "binary_log"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -216,6 +218,16 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.Optional(CONF_BINARY_LOG): cv.All(
+                cv.only_on_esp32,
+                cv.Schema(
+                    {
+                        cv.Optional(CONF_BUFFER_SIZE, default="4kB"): cv.All(
+                            cv.validate_bytes, cv.int_range(min=512)
+                        ),
+                    }
+                ),
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
@@ -278,6 +290,9 @@ async def to_code(config):
         cg.add_build_flag("-DENABLE_I2C_DEBUG_BUFFER")
     if config.get(CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH):
         cg.add_build_flag("-DUSE_STORE_LOG_STR_IN_FLASH")
+    if binary_log_config := config.get(CONF_BINARY_LOG):
+        cg.add_define("USE_LOGGER_BINARY")
+        cg.add(log.set_binary_log_buffer_size(binary_log_config[CONF_BUFFER_SIZE]))
 
     if CORE.using_arduino:
         if config[CONF_HARDWARE_UART] == USB_CDC:
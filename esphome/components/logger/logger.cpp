@@ -31,7 +31,22 @@ static const char *const LOG_LEVEL_LETTERS[] = {
     "VV",  // VERY_VERBOSE
 };
 
-void Logger::write_header_(int level, const char *tag, int line) {
+const char *Logger::get_thread_name_() {
+#if defined(USE_ESP32) || defined(USE_LIBRETINY)
+  TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
+  if (current_task == this->main_task_)
+    return nullptr;
+#if defined(USE_ESP32)
+  return pcTaskGetName(current_task);
+#else
+  return pcTaskGetTaskName(current_task);
+#endif
+#else
+  return nullptr;
+#endif
+}
+
+void Logger::write_header_(int level, const char *tag, int line, const char *thread_name) {
   if (level < 0)
     level = 0;
   if (level > 7)
@@ -39,32 +54,31 @@ void Logger::write_header_(int level, const char *tag, int line) {
 
   const char *color = LOG_LEVEL_COLORS[level];
   const char *letter = LOG_LEVEL_LETTERS[level];
-#if defined(USE_ESP32) || defined(USE_LIBRETINY)
-  TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
-#else
-  void *current_task = nullptr;
-#endif
-  if (current_task == main_task_) {
+  if (thread_name == nullptr) {
     this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
   } else {
-    const char *thread_name = "";  // NOLINT(clang-analyzer-deadcode.DeadStores)
-#if defined(USE_ESP32)
-    thread_name = pcTaskGetName(current_task);
-#elif defined(USE_LIBRETINY)
-    thread_name = pcTaskGetTaskName(current_task);
-#endif
     this->printf_to_buffer_("%s[%s][%s:%03u]%s[%s]%s: ", color, letter, tag, line,
                             ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED), thread_name, color);
   }
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+#ifdef USE_LOGGER_BINARY
+  if (this->binary_active_) {
+    // Messages logged by the log callbacks themselves are still dropped, other tasks are never blocked
+    if (!recursion_guard_ || xTaskGetCurrentTaskHandle() != this->main_task_)
+      this->queue_binary_(level, tag, line, format, args);
+    return;
+  }
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
   this->reset_buffer_();
-  this->write_header_(level, tag, line);
+  this->write_header_(level, tag, line, this->get_thread_name_());
   this->vprintf_to_buffer_(format, args);
   this->write_footer_();
   this->log_message_(level, tag);
@@ -93,7 +107,7 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
   uint32_t offset = this->tx_buffer_at_;
 
   // now apply vsnprintf
-  this->write_header_(level, tag, line);
+  this->write_header_(level, tag, line, this->get_thread_name_());
   this->vprintf_to_buffer_(this->tx_buffer_, args);
   this->write_footer_();
   this->log_message_(level, tag, offset);
@@ -148,9 +162,13 @@ Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate
 #endif
 }
 
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_BINARY)
 void Logger::loop() {
-#ifdef USE_ARDUINO
+#ifdef USE_LOGGER_BINARY
+  this->binary_active_ = this->binary_buffer_ != nullptr;
+  this->process_binary_();
+#endif
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
   if (this->uart_ != UART_SELECTION_USB_CDC) {
     return;
   }
@@ -164,6 +182,16 @@ void Logger::loop() {
   opened = !opened;
 #endif
 }
+
+bool Logger::needs_polling() const {
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
+  // The USB CDC connection state can only be polled
+  if (this->uart_ == UART_SELECTION_USB_CDC)
+    return true;
+#endif
+  // Queued binary records wake the loop, see queue_binary_()
+  return false;
+}
 #endif
 
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
@@ -188,6 +216,9 @@ void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %" PRIu32, this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", get_uart_selection_());
 #endif
+#ifdef USE_LOGGER_BINARY
+  ESP_LOGCONFIG(TAG, "  Binary Logging: %s", YESNO(this->binary_buffer_ != nullptr));
+#endif
 
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
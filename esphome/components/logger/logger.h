@@ -21,6 +21,12 @@
 #include <driver/uart.h>
 #endif  // USE_ESP_IDF
 
+#ifdef USE_LOGGER_BINARY
+#include <atomic>
+#include <memory>
+#include "esphome/core/ring_buffer.h"
+#endif  // USE_LOGGER_BINARY
+
 namespace esphome {
 
 namespace logger {
@@ -56,8 +62,18 @@ enum UARTSelection {
 class Logger : public Component {
  public:
   explicit Logger(uint32_t baud_rate, size_t tx_buffer_size);
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_BINARY)
   void loop() override;
+  bool needs_polling() const override;
+#endif
+#ifdef USE_LOGGER_BINARY
+  /** Enable binary logging with a ring buffer of the given size.
+   *
+   * Once the main loop runs, log calls only copy the level, tag, line, format pointer and raw arguments into the
+   * ring buffer. The lines are formatted and passed to the log callbacks from loop(), so callers on any task don't
+   * pay for vsnprintf or for sending the line over UART, the API or MQTT.
+   */
+  void set_binary_log_buffer_size(size_t size);
 #endif
   /// Manually set the baud rate for serial, set to 0 to disable.
   void set_baud_rate(uint32_t baud_rate);
@@ -96,7 +112,9 @@ class Logger : public Component {
 #endif
 
  protected:
-  void write_header_(int level, const char *tag, int line);
+  /// Name of the calling task, or nullptr if called from the main loop task.
+  const char *get_thread_name_();
+  void write_header_(int level, const char *tag, int line, const char *thread_name);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
   void write_msg_(const char *msg);
@@ -143,6 +161,32 @@ class Logger : public Component {
   const char *get_uart_selection_();
 #endif
 
+#ifdef USE_LOGGER_BINARY
+  /// Header of a record in the binary log ring buffer, followed by the thread name and the serialized arguments.
+  /// Tag and format are referenced by pointer when they live in flash. Any other string may be gone by the time the
+  /// record is formatted, so its text is copied into the record after the thread name, with its length set here.
+  struct BinaryLogRecord {
+    const char *tag;
+    const char *format;
+    uint16_t line;
+    uint8_t level;
+    uint8_t thread_name_len;
+    uint16_t args_len;
+    uint8_t tag_len;
+    uint16_t format_len;
+  };
+  void queue_binary_(int level, const char *tag, int line, const char *format, va_list args);
+  void process_binary_();
+  void format_binary_(const char *format, const uint8_t *args, size_t args_len);
+
+  std::unique_ptr<RingBuffer> binary_buffer_;
+  std::atomic<uint32_t> binary_dropped_{0};
+  /// Keeps the main loop spinning while more records are queued than one loop() call formats.
+  HighFrequencyLoopRequester binary_backlog_;
+  /// Set once loop() runs; messages logged before that are formatted synchronously.
+  std::atomic<bool> binary_active_{false};
+#endif
+
   uint32_t baud_rate_;
   char *tx_buffer_{nullptr};
   int tx_buffer_at_{0};
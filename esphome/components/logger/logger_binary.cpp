@@ -0,0 +1,476 @@
+#include "logger.h"
+
+#ifdef USE_LOGGER_BINARY
+
+#include <cinttypes>
+#include <cstring>
+
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION_MAJOR >= 5
+#include <esp_memory_utils.h>
+#else
+#include <soc/soc_memory_layout.h>
+#endif
+
+namespace esphome {
+namespace logger {
+
+static const char *const TAG = "logger";
+
+/// Largest record queued for a single message, string arguments are truncated to fit.
+static const size_t BINARY_LOG_MAX_RECORD_SIZE = 256;
+/// Longest tag copied into a record, leaving the rest of the record for the format and the arguments.
+static const size_t BINARY_LOG_MAX_TAG_LENGTH = 31;
+/// Maximum number of records formatted per loop() call.
+static const uint8_t BINARY_LOG_MAX_RECORDS_PER_LOOP = 16;
+
+/// How a printf argument is passed through the varargs and stored in a record.
+enum class BinaryArgType : uint8_t {
+  NONE,
+  INT,
+  LONG,
+  LONG_LONG,
+  SIZE,
+  INTMAX,
+  PTRDIFF,
+  DOUBLE,
+  LONG_DOUBLE,
+  POINTER,
+  STRING,
+  WRITE_COUNT,
+};
+
+/// A single printf conversion specification, split into its parts.
+struct BinaryFormatSpec {
+  const char *flags;      ///< First character after the '%'
+  const char *width;      ///< Start of the width
+  const char *precision;  ///< The '.' of the precision, nullptr if there is none
+  const char *length;     ///< Start of the length modifier and conversion character
+  const char *end;        ///< One past the conversion character
+  bool width_arg;         ///< Width is passed as an int argument ('*')
+  bool precision_arg;     ///< Precision is passed as an int argument ('.*')
+  int precision_value;    ///< Literal precision, -1 if none was given
+  BinaryArgType type;
+};
+
+static BinaryFormatSpec parse_format_spec(const char *p) {
+  BinaryFormatSpec spec{};
+  spec.precision_value = -1;
+  spec.flags = p;
+  while (*p != '\0' && strchr("-+ #0", *p) != nullptr)
+    p++;
+  spec.width = p;
+  if (*p == '*') {
+    spec.width_arg = true;
+    p++;
+  } else {
+    while (*p >= '0' && *p <= '9')
+      p++;
+  }
+  if (*p == '.') {
+    spec.precision = p++;
+    if (*p == '*') {
+      spec.precision_arg = true;
+      p++;
+    } else {
+      spec.precision_value = 0;
+      while (*p >= '0' && *p <= '9')
+        spec.precision_value = spec.precision_value * 10 + (*p++ - '0');
+    }
+  }
+  spec.length = p;
+  char length = 0;  // 'H' for ll, 'D' for L
+  switch (*p) {
+    case 'h':
+      // char and short are promoted to int
+      p++;
+      if (*p == 'h')
+        p++;
+      break;
+    case 'l':
+      p++;
+      length = 'l';
+      if (*p == 'l') {
+        p++;
+        length = 'H';
+      }
+      break;
+    case 'L':
+      p++;
+      length = 'D';
+      break;
+    case 'z':
+    case 'j':
+    case 't':
+      length = *p++;
+      break;
+    default:
+      break;
+  }
+  char conversion = *p;
+  if (conversion != '\0')
+    p++;
+  spec.end = p;
+
+  switch (conversion) {
+    case 'd':
+    case 'i':
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+      switch (length) {
+        case 'l':
+          spec.type = BinaryArgType::LONG;
+          break;
+        case 'H':
+        case 'D':
+          spec.type = BinaryArgType::LONG_LONG;
+          break;
+        case 'z':
+          spec.type = BinaryArgType::SIZE;
+          break;
+        case 'j':
+          spec.type = BinaryArgType::INTMAX;
+          break;
+        case 't':
+          spec.type = BinaryArgType::PTRDIFF;
+          break;
+        default:
+          spec.type = BinaryArgType::INT;
+          break;
+      }
+      break;
+    case 'c':
+      spec.type = BinaryArgType::INT;
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      spec.type = length == 'D' ? BinaryArgType::LONG_DOUBLE : BinaryArgType::DOUBLE;
+      break;
+    case 's':
+      spec.type = BinaryArgType::STRING;
+      break;
+    case 'p':
+      spec.type = BinaryArgType::POINTER;
+      break;
+    case 'n':
+      spec.type = BinaryArgType::WRITE_COUNT;
+      break;
+    default:
+      // "%%" or an unknown conversion, neither takes an argument
+      spec.type = BinaryArgType::NONE;
+      break;
+  }
+  return spec;
+}
+
+template<typename T> static bool put_binary_arg(uint8_t *out, size_t capacity, size_t &pos, T value) {
+  if (pos + sizeof(T) > capacity)
+    return false;
+  memcpy(out + pos, &value, sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+template<typename T> static bool get_binary_arg(const uint8_t *in, size_t len, size_t &pos, T &value) {
+  if (pos + sizeof(T) > len)
+    return false;
+  memcpy(&value, in + pos, sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+/// Copy the raw values of all arguments referenced by format into out. Returns the number of bytes used.
+static size_t serialize_binary_args(const char *format, va_list args, uint8_t *out, size_t capacity) {
+  size_t pos = 0;
+  for (const char *p = format; *p != '\0'; p++) {
+    if (*p != '%')
+      continue;
+    BinaryFormatSpec spec = parse_format_spec(p + 1);
+    p = spec.end - 1;
+
+    if (spec.width_arg && !put_binary_arg(out, capacity, pos, va_arg(args, int)))
+      return pos;
+    int precision = spec.precision_value;
+    if (spec.precision_arg) {
+      precision = va_arg(args, int);
+      if (!put_binary_arg(out, capacity, pos, precision))
+        return pos;
+    }
+
+    bool stored = true;
+    switch (spec.type) {
+      case BinaryArgType::NONE:
+        break;
+      case BinaryArgType::INT:
+        stored = put_binary_arg(out, capacity, pos, va_arg(args, int));
+        break;
+      case BinaryArgType::LONG:
+        stored = put_binary_arg(out, capacity, pos, va_arg(args, long));
+        break;
+      case BinaryArgType::LONG_LONG:
+        stored = put_binary_arg(out, capacity, pos, va_arg(args, long long));
+        break;
+      case BinaryArgType::SIZE:
+        stored = put_binary_arg(out, capacity, pos, va_arg(args, size_t));
+        break;
+      case BinaryArgType::INTMAX:
+        stored = put_binary_arg(out, capacity, pos, va_arg(args, intmax_t));
+        break;
+      case BinaryArgType::PTRDIFF:
+        stored = put_binary_arg(out, capacity, pos, va_arg(args, ptrdiff_t));
+        break;
+      case BinaryArgType::DOUBLE:
+        stored = put_binary_arg(out, capacity, pos, va_arg(args, double));
+        break;
+      case BinaryArgType::LONG_DOUBLE:
+        stored = put_binary_arg(out, capacity, pos, va_arg(args, long double));
+        break;
+      case BinaryArgType::POINTER:
+      case BinaryArgType::WRITE_COUNT:
+        stored = put_binary_arg(out, capacity, pos, va_arg(args, void *));
+        break;
+      case BinaryArgType::STRING: {
+        // The string may not outlive the log call, so its contents are copied with the precision already applied
+        const char *str = va_arg(args, const char *);
+        if (str == nullptr)
+          str = "(null)";
+        size_t str_len = precision >= 0 ? strnlen(str, precision) : strlen(str);
+        if (pos + sizeof(uint16_t) > capacity)
+          return pos;
+        str_len = std::min(str_len, capacity - pos - sizeof(uint16_t));
+        put_binary_arg(out, capacity, pos, static_cast<uint16_t>(str_len));
+        memcpy(out + pos, str, str_len);
+        pos += str_len;
+        break;
+      }
+    }
+    if (!stored)
+      return pos;
+  }
+  return pos;
+}
+
+void Logger::set_binary_log_buffer_size(size_t size) {
+  // If the allocation fails, messages keep being formatted synchronously
+  this->binary_buffer_ = RingBuffer::create(size);
+}
+
+/// Copy str into the record unless it is a literal in flash, which outlives every record. Returns the number of bytes
+/// copied including the terminator, 0 if only the pointer is kept. Text that doesn't fit is truncated.
+static size_t copy_binary_string(const char *str, uint8_t *out, size_t capacity, size_t max_len) {
+  if (str == nullptr || esp_ptr_in_drom(str))
+    return 0;
+  size_t len = std::min(strnlen(str, max_len), capacity - 1);
+  memcpy(out, str, len);
+  out[len] = '\0';
+  return len + 1;
+}
+
+void HOT Logger::queue_binary_(int level, const char *tag, int line, const char *format, va_list args) {
+  uint8_t record[BINARY_LOG_MAX_RECORD_SIZE];
+  BinaryLogRecord header{};
+  header.tag = tag;
+  header.format = format;
+  header.line = line;
+  header.level = level;
+
+  size_t pos = sizeof(BinaryLogRecord);
+  const char *thread_name = this->get_thread_name_();
+  if (thread_name != nullptr) {
+    header.thread_name_len = strnlen(thread_name, configMAX_TASK_NAME_LEN);
+    memcpy(record + pos, thread_name, header.thread_name_len);
+    pos += header.thread_name_len;
+  }
+  // A format built at runtime (for example from a std::string) is freed right after the log call returns
+  header.tag_len = copy_binary_string(tag, record + pos, sizeof(record) - pos, BINARY_LOG_MAX_TAG_LENGTH);
+  pos += header.tag_len;
+  header.format_len = copy_binary_string(format, record + pos, sizeof(record) - pos, sizeof(record));
+  if (header.format_len > 0)
+    format = reinterpret_cast<const char *>(record + pos);
+  pos += header.format_len;
+  header.args_len = serialize_binary_args(format, args, record + pos, sizeof(record) - pos);
+  pos += header.args_len;
+  memcpy(record, &header, sizeof(BinaryLogRecord));
+
+  // Each record is written in one piece, so records from different tasks never interleave
+  if (!this->binary_buffer_->write_atomic(record, pos)) {
+    this->binary_dropped_++;
+    return;
+  }
+#ifdef USE_LOOP_EVENT_DRIVEN
+  App.wake_loop();
+#endif
+}
+
+void Logger::format_binary_(const char *format, const uint8_t *args, size_t args_len) {
+  size_t pos = 0;
+  const char *p = format;
+  while (*p != '\0') {
+    const char *percent = strchr(p, '%');
+    if (percent == nullptr) {
+      this->write_to_buffer_(p, strlen(p));
+      return;
+    }
+    this->write_to_buffer_(p, percent - p);
+    BinaryFormatSpec spec = parse_format_spec(percent + 1);
+    p = spec.end;
+
+    // Rebuild the conversion with the '*' values that were queued filled in
+    char conversion[32];
+    size_t literal_len = (spec.width - spec.flags) + (spec.end - spec.length);
+    if (literal_len + 24 > sizeof(conversion)) {
+      this->write_to_buffer_(percent, spec.end - percent);
+      continue;
+    }
+    size_t n = 0;
+    conversion[n++] = '%';
+    memcpy(conversion + n, spec.flags, spec.width - spec.flags);
+    n += spec.width - spec.flags;
+    if (spec.width_arg) {
+      int width;
+      if (!get_binary_arg(args, args_len, pos, width))
+        return;
+      n += snprintf(conversion + n, sizeof(conversion) - n, "%d", width);
+    } else {
+      const char *width_end = spec.precision != nullptr ? spec.precision : spec.length;
+      memcpy(conversion + n, spec.width, width_end - spec.width);
+      n += width_end - spec.width;
+    }
+    int precision = spec.precision_value;
+    if (spec.precision_arg && !get_binary_arg(args, args_len, pos, precision))
+      return;
+    if (spec.type == BinaryArgType::STRING) {
+      memcpy(conversion + n, ".*", 2);
+      n += 2;
+    } else if (spec.precision != nullptr && precision >= 0) {
+      n += snprintf(conversion + n, sizeof(conversion) - n, ".%d", precision);
+    }
+    memcpy(conversion + n, spec.length, spec.end - spec.length);
+    n += spec.end - spec.length;
+    conversion[n] = '\0';
+
+    auto print = [this, &conversion, args, args_len, &pos](auto value) {
+      if (!get_binary_arg(args, args_len, pos, value))
+        return false;
+      this->printf_to_buffer_(conversion, value);
+      return true;
+    };
+    bool printed = true;
+    switch (spec.type) {
+      case BinaryArgType::NONE:
+        if (spec.end[-1] == '%')
+          this->write_to_buffer_('%');
+        break;
+      case BinaryArgType::INT:
+        printed = print(int{});
+        break;
+      case BinaryArgType::LONG:
+        printed = print(long{});
+        break;
+      case BinaryArgType::LONG_LONG:
+        printed = print(0LL);
+        break;
+      case BinaryArgType::SIZE:
+        printed = print(size_t{});
+        break;
+      case BinaryArgType::INTMAX:
+        printed = print(intmax_t{});
+        break;
+      case BinaryArgType::PTRDIFF:
+        printed = print(ptrdiff_t{});
+        break;
+      case BinaryArgType::DOUBLE:
+        printed = print(double{});
+        break;
+      case BinaryArgType::LONG_DOUBLE:
+        printed = print(0.0L);
+        break;
+      case BinaryArgType::POINTER:
+        printed = print(static_cast<void *>(nullptr));
+        break;
+      case BinaryArgType::WRITE_COUNT: {
+        // Nothing to print, and the target of %n is gone by now
+        void *target;
+        printed = get_binary_arg(args, args_len, pos, target);
+        break;
+      }
+      case BinaryArgType::STRING: {
+        uint16_t str_len;
+        printed = get_binary_arg(args, args_len, pos, str_len) && pos + str_len <= args_len;
+        if (printed) {
+          this->printf_to_buffer_(conversion, static_cast<int>(str_len), reinterpret_cast<const char *>(args + pos));
+          pos += str_len;
+        }
+        break;
+      }
+    }
+    // Arguments that didn't fit into the record end the message
+    if (!printed)
+      return;
+  }
+}
+
+void Logger::process_binary_() {
+  if (this->binary_buffer_ == nullptr)
+    return;
+
+  uint8_t payload[BINARY_LOG_MAX_RECORD_SIZE];
+  char thread_name[configMAX_TASK_NAME_LEN + 1];
+  for (uint8_t i = 0; i < BINARY_LOG_MAX_RECORDS_PER_LOOP; i++) {
+    if (this->binary_buffer_->available() < sizeof(BinaryLogRecord)) {
+      this->binary_backlog_.stop();
+      break;
+    }
+    BinaryLogRecord header;
+    this->binary_buffer_->read(&header, sizeof(BinaryLogRecord));
+    size_t payload_len = header.thread_name_len + header.tag_len + header.format_len + header.args_len;
+    if (payload_len > 0 && this->binary_buffer_->read(payload, payload_len) != payload_len) {
+      // Records are written in one piece, so this can only mean the buffer is corrupted
+      this->binary_buffer_->reset();
+      break;
+    }
+
+    const char *thread = nullptr;
+    if (header.thread_name_len > 0) {
+      memcpy(thread_name, payload, header.thread_name_len);
+      thread_name[header.thread_name_len] = '\0';
+      thread = thread_name;
+    }
+
+    const uint8_t *text = payload + header.thread_name_len;
+    const char *tag = header.tag_len > 0 ? reinterpret_cast<const char *>(text) : header.tag;
+    text += header.tag_len;
+    const char *format = header.format_len > 0 ? reinterpret_cast<const char *>(text) : header.format;
+    text += header.format_len;
+
+    this->recursion_guard_ = true;
+    this->reset_buffer_();
+    this->write_header_(header.level, tag, header.line, thread);
+    this->format_binary_(format, text, header.args_len);
+    this->write_footer_();
+    this->log_message_(header.level, tag);
+    this->recursion_guard_ = false;
+  }
+  if (this->binary_buffer_->available() > 0)
+    this->binary_backlog_.start();
+
+  uint32_t dropped = this->binary_dropped_.exchange(0);
+  if (dropped > 0)
+    ESP_LOGW(TAG, "Dropped %" PRIu32 " log messages, consider a larger binary_log buffer_size", dropped);
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_BINARY
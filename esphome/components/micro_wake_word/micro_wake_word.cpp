@@ -14,6 +14,8 @@
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_mutable_op_resolver.h>
 
+#include <algorithm>
+#include <cinttypes>
 #include <cmath>
 
 namespace esphome {
@@ -21,10 +23,8 @@ namespace micro_wake_word {
 
 static const char *const TAG = "micro_wake_word";
 
-static const size_t SAMPLE_RATE_HZ = 16000;  // 16 kHz
-static const size_t BUFFER_LENGTH = 64;      // 0.064 seconds
-static const size_t BUFFER_SIZE = SAMPLE_RATE_HZ / 1000 * BUFFER_LENGTH;
-static const size_t INPUT_BUFFER_SIZE = 16 * SAMPLE_RATE_HZ / 1000;  // 16ms * 16kHz / 1000ms
+static const uint32_t INFERENCE_TASK_STACK_SIZE = 4096;
+static const UBaseType_t INFERENCE_TASK_PRIORITY = 3;
 
 float MicroWakeWord::get_setup_priority() const { return setup_priority::AFTER_CONNECTION; }
 
@@ -56,6 +56,11 @@ void MicroWakeWord::dump_config() {
 #ifdef USE_MICRO_WAKE_WORD_VAD
   this->vad_model_->log_model_config();
 #endif
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Feature Queue Depth", this->queue_depth_sensor_);
+  for (auto &inference_time : this->inference_time_sensors_)
+    LOG_SENSOR("  ", "Inference Time", inference_time.sensor);
+#endif
 }
 
 void MicroWakeWord::setup() {
@@ -66,6 +71,27 @@ void MicroWakeWord::setup() {
     return;
   }
 
+  this->microphone_consumer_ = this->microphone_->get_audio_ring().add_consumer();
+
+  // Value initialized, so all totals start at zero
+  this->model_inference_time_ = make_unique<std::atomic<uint32_t>[]>(this->wake_word_models_.size());
+#ifdef USE_SENSOR
+  this->set_interval("inference_stats", 60000, [this]() { this->publish_inference_stats_(); });
+#endif
+
+#if portNUM_PROCESSORS > 1
+  // Run inference on the core the main loop is not using
+  BaseType_t core = 1 - xPortGetCoreID();
+#else
+  BaseType_t core = tskNO_AFFINITY;
+#endif
+  if (xTaskCreatePinnedToCore(MicroWakeWord::inference_task, "mww_inference", INFERENCE_TASK_STACK_SIZE, this,
+                              INFERENCE_TASK_PRIORITY, &this->inference_task_handle_, core) != pdPASS) {
+    ESP_LOGE(TAG, "Could not create the inference task");
+    this->mark_failed();
+    return;
+  }
+
   ESP_LOGCONFIG(TAG, "Micro Wake Word initialized");
 
   this->frontend_config_.window.size_ms = FEATURE_DURATION_MS;
@@ -92,6 +118,12 @@ void MicroWakeWord::add_wake_word_model(const uint8_t *model_start, float probab
                                        tensor_arena_size);
 }
 
+#ifdef USE_SENSOR
+void MicroWakeWord::add_inference_time_sensor(sensor::Sensor *sensor, const std::string &wake_word) {
+  this->inference_time_sensors_.push_back(InferenceTimeSensor{sensor, wake_word, 0});
+}
+#endif
+
 #ifdef USE_MICRO_WAKE_WORD_VAD
 void MicroWakeWord::add_vad_model(const uint8_t *model_start, float probability_cutoff, size_t sliding_window_size,
                                   size_t tensor_arena_size) {
@@ -111,15 +143,19 @@ void MicroWakeWord::loop() {
       break;
     case State::STARTING_MICROPHONE:
       if (this->microphone_->is_running()) {
+        this->microphone_->get_audio_ring().start_reading(this->microphone_consumer_);
+        this->inference_enabled_.store(true);
         this->set_state_(State::DETECTING_WAKE_WORD);
       }
       break;
     case State::DETECTING_WAKE_WORD:
-      while (!this->has_enough_samples_()) {
-        this->read_microphone_();
-      }
-      this->update_model_probabilities_();
-      if (this->detect_wake_words_()) {
+      this->check_overruns_();
+      this->queue_features_();
+#ifdef USE_MICRO_WAKE_WORD_VAD
+      if (this->vad_rejections_.exchange(0, std::memory_order_relaxed) > 0)
+        ESP_LOGD(TAG, "A wake word model predicts a wake word, but the VAD model doesn't.");
+#endif
+      if (this->inference_detected_.exchange(false, std::memory_order_acquire)) {
         ESP_LOGD(TAG, "Wake Word '%s' Detected", (this->detected_wake_word_).c_str());
         this->detected_ = true;
         this->set_state_(State::STOP_MICROPHONE);
@@ -127,14 +163,17 @@ void MicroWakeWord::loop() {
       break;
     case State::STOP_MICROPHONE:
       ESP_LOGD(TAG, "Stopping Microphone");
+      this->inference_enabled_.store(false);
+      this->microphone_->get_audio_ring().stop_reading(this->microphone_consumer_);
       this->microphone_->stop();
       this->set_state_(State::STOPPING_MICROPHONE);
       this->high_freq_.stop();
-      this->unload_models_();
-      this->deallocate_buffers_();
       break;
     case State::STOPPING_MICROPHONE:
-      if (this->microphone_->is_stopped()) {
+      // The models can only be unloaded once the inference task is done with them
+      if (this->microphone_->is_stopped() && !this->inference_busy_.load()) {
+        this->unload_models_();
+        this->deallocate_buffers_();
         this->set_state_(State::IDLE);
         if (this->detected_) {
           this->wake_word_detected_trigger_->trigger(this->detected_wake_word_);
@@ -157,6 +196,12 @@ void MicroWakeWord::start() {
     return;
   }
 
+  // The models may still be in use by the inference task while stopping
+  if (this->state_ != State::IDLE) {
+    ESP_LOGW(TAG, "Wake word is already running");
+    return;
+  }
+
   if (!this->load_models_() || !this->allocate_buffers_()) {
     ESP_LOGE(TAG, "Failed to load the wake word model(s) or allocate buffers");
     this->status_set_error();
@@ -169,11 +214,6 @@ void MicroWakeWord::start() {
     return;
   }
 
-  if (this->state_ != State::IDLE) {
-    ESP_LOGW(TAG, "Wake word is already running");
-    return;
-  }
-
   this->reset_states_();
   this->set_state_(State::START_MICROPHONE);
 }
@@ -196,37 +236,20 @@ void MicroWakeWord::set_state_(State state) {
   this->state_ = state;
 }
 
-size_t MicroWakeWord::read_microphone_() {
-  size_t bytes_read = this->microphone_->read(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-  if (bytes_read == 0) {
-    return 0;
-  }
-
-  size_t bytes_free = this->ring_buffer_->free();
-
-  if (bytes_free < bytes_read) {
-    ESP_LOGW(TAG,
-             "Not enough free bytes in ring buffer to store incoming audio data (free bytes=%d, incoming bytes=%d). "
-             "Resetting the ring buffer. Wake word detection accuracy will be reduced.",
-             bytes_free, bytes_read);
-
-    this->ring_buffer_->reset();
-  }
-
-  return this->ring_buffer_->write((void *) this->input_buffer_, bytes_read);
+void MicroWakeWord::check_overruns_() {
+  uint32_t overruns = this->microphone_->get_audio_ring().get_overruns(this->microphone_consumer_);
+  if (overruns == this->reported_overruns_)
+    return;
+  ESP_LOGW(TAG,
+           "Audio was lost %" PRIu32 " times as wake word detection couldn't keep up with the microphone. "
+           "Wake word detection accuracy will be reduced.",
+           overruns - this->reported_overruns_);
+  this->reported_overruns_ = overruns;
 }
 
 bool MicroWakeWord::allocate_buffers_() {
   ExternalRAMAllocator<int16_t> audio_samples_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
 
-  if (this->input_buffer_ == nullptr) {
-    this->input_buffer_ = audio_samples_allocator.allocate(INPUT_BUFFER_SIZE * sizeof(int16_t));
-    if (this->input_buffer_ == nullptr) {
-      ESP_LOGE(TAG, "Could not allocate input buffer");
-      return false;
-    }
-  }
-
   if (this->preprocessor_audio_buffer_ == nullptr) {
     this->preprocessor_audio_buffer_ = audio_samples_allocator.allocate(this->new_samples_to_get_());
     if (this->preprocessor_audio_buffer_ == nullptr) {
@@ -235,21 +258,11 @@ bool MicroWakeWord::allocate_buffers_() {
     }
   }
 
-  if (this->ring_buffer_ == nullptr) {
-    this->ring_buffer_ = RingBuffer::create(BUFFER_SIZE * sizeof(int16_t));
-    if (this->ring_buffer_ == nullptr) {
-      ESP_LOGE(TAG, "Could not allocate ring buffer");
-      return false;
-    }
-  }
-
   return true;
 }
 
 void MicroWakeWord::deallocate_buffers_() {
   ExternalRAMAllocator<int16_t> audio_samples_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
-  audio_samples_allocator.deallocate(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-  this->input_buffer_ = nullptr;
   audio_samples_allocator.deallocate(this->preprocessor_audio_buffer_, this->new_samples_to_get_());
   this->preprocessor_audio_buffer_ = nullptr;
 }
@@ -290,22 +303,103 @@ void MicroWakeWord::unload_models_() {
 #endif
 }
 
-void MicroWakeWord::update_model_probabilities_() {
-  int8_t audio_features[PREPROCESSOR_FEATURE_SIZE];
-
-  if (!this->generate_features_for_window_(audio_features)) {
+void MicroWakeWord::queue_features_() {
+  uint32_t head = this->feature_head_.load(std::memory_order_relaxed);
+  uint32_t queued = 0;
+  // Catch up with everything the microphone recorded since the last loop. When the inference task falls behind, the
+  // audio waits in the microphone's buffer instead.
+  while (head - this->feature_tail_.load(std::memory_order_acquire) < FEATURE_QUEUE_SIZE &&
+         this->generate_features_for_window_(this->feature_queue_[head % FEATURE_QUEUE_SIZE])) {
+    this->feature_head_.store(++head, std::memory_order_release);
+    queued++;
+  }
+  if (queued == 0)
     return;
+
+  uint32_t depth = head - this->feature_tail_.load(std::memory_order_acquire);
+  if (depth > this->max_queue_depth_)
+    this->max_queue_depth_ = depth;
+  xTaskNotifyGive(this->inference_task_handle_);
+}
+
+void MicroWakeWord::inference_task(void *params) {
+  auto *mww = reinterpret_cast<MicroWakeWord *>(params);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (mww->process_queued_features_()) {
+    }
+  }
+}
+
+bool MicroWakeWord::process_queued_features_() {
+  // Marked busy before checking if enabled: once the main loop disabled inference and sees the task isn't busy, the
+  // task won't touch the models anymore
+  this->inference_busy_.store(true);
+  if (!this->inference_enabled_.load()) {
+    this->inference_busy_.store(false);
+    return false;
   }
 
+  uint32_t tail = this->feature_tail_.load(std::memory_order_relaxed);
+  uint32_t head = this->feature_head_.load(std::memory_order_acquire);
+  bool processed = tail != head;
+  // All frames queued so far are run through the models in one go
+  for (; tail != head; tail++) {
+    this->update_model_probabilities_(this->feature_queue_[tail % FEATURE_QUEUE_SIZE]);
+    this->feature_tail_.store(tail + 1, std::memory_order_release);
+    if (this->detect_wake_words_()) {
+      this->inference_enabled_.store(false);
+      this->inference_detected_.store(true, std::memory_order_release);
+      processed = false;
+      break;
+    }
+  }
+
+  this->inference_busy_.store(false);
+  return processed;
+}
+
+void MicroWakeWord::update_model_probabilities_(const int8_t features[PREPROCESSOR_FEATURE_SIZE]) {
   // Increase the counter since the last positive detection
   this->ignore_windows_ = std::min(this->ignore_windows_ + 1, 0);
 
-  for (auto &model : this->wake_word_models_) {
-    // Perform inference
-    model.perform_streaming_inference(audio_features);
+  for (size_t i = 0; i < this->wake_word_models_.size(); i++) {
+    uint32_t start = micros();
+    this->wake_word_models_[i].perform_streaming_inference(features);
+    this->model_inference_time_[i].fetch_add(micros() - start, std::memory_order_relaxed);
   }
 #ifdef USE_MICRO_WAKE_WORD_VAD
-  this->vad_model_->perform_streaming_inference(audio_features);
+  uint32_t start = micros();
+  this->vad_model_->perform_streaming_inference(features);
+  this->vad_inference_time_.fetch_add(micros() - start, std::memory_order_relaxed);
+#endif
+  this->inference_frames_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MicroWakeWord::publish_inference_stats_() {
+#ifdef USE_SENSOR
+  if (this->queue_depth_sensor_ != nullptr)
+    this->queue_depth_sensor_->publish_state(this->max_queue_depth_);
+  this->max_queue_depth_ = 0;
+
+  uint32_t frames = this->inference_frames_.load(std::memory_order_relaxed);
+  uint32_t new_frames = frames - this->published_frames_;
+  this->published_frames_ = frames;
+  for (auto &inference_time : this->inference_time_sensors_) {
+    uint32_t time = 0;
+    for (size_t i = 0; i < this->wake_word_models_.size(); i++) {
+      if (inference_time.wake_word.empty() || inference_time.wake_word == this->wake_word_models_[i].get_wake_word())
+        time += this->model_inference_time_[i].load(std::memory_order_relaxed);
+    }
+#ifdef USE_MICRO_WAKE_WORD_VAD
+    if (inference_time.wake_word.empty())
+      time += this->vad_inference_time_.load(std::memory_order_relaxed);
+#endif
+    // Average per feature frame, in milliseconds
+    if (new_frames > 0)
+      inference_time.sensor->publish_state((time - inference_time.last_time) / 1000.0f / new_frames);
+    inference_time.last_time = time;
+  }
 #endif
 }
 
@@ -328,7 +422,8 @@ bool MicroWakeWord::detect_wake_words_() {
         return true;
 #ifdef USE_MICRO_WAKE_WORD_VAD
       } else {
-        ESP_LOGD(TAG, "Wake word model predicts %s, but VAD model doesn't.", model.get_wake_word().c_str());
+        // Logged by the main loop, as this runs in the inference task
+        this->vad_rejections_.fetch_add(1, std::memory_order_relaxed);
       }
 #endif
     }
@@ -338,8 +433,7 @@ bool MicroWakeWord::detect_wake_words_() {
 }
 
 bool MicroWakeWord::has_enough_samples_() {
-  return this->ring_buffer_->available() >=
-         (this->features_step_size_ * (AUDIO_SAMPLE_FREQUENCY / 1000)) * sizeof(int16_t);
+  return this->microphone_->get_audio_ring().available(this->microphone_consumer_) >= this->new_samples_to_get_();
 }
 
 bool MicroWakeWord::generate_features_for_window_(int8_t features[PREPROCESSOR_FEATURE_SIZE]) {
@@ -348,21 +442,20 @@ bool MicroWakeWord::generate_features_for_window_(int8_t features[PREPROCESSOR_F
     return false;
   }
 
-  size_t bytes_read = this->ring_buffer_->read((void *) (this->preprocessor_audio_buffer_),
-                                               this->new_samples_to_get_() * sizeof(int16_t), pdMS_TO_TICKS(200));
-
-  if (bytes_read == 0) {
-    ESP_LOGE(TAG, "Could not read data from Ring Buffer");
-  } else if (bytes_read < this->new_samples_to_get_() * sizeof(int16_t)) {
-    ESP_LOGD(TAG, "Partial Read of Data by Model");
-    ESP_LOGD(TAG, "Could only read %d bytes when required %d bytes ", bytes_read,
-             (int) (this->new_samples_to_get_() * sizeof(int16_t)));
-    return false;
+  // Use the samples in place, unless they wrap around the end of the microphone's buffer
+  microphone::AudioRing &audio_ring = this->microphone_->get_audio_ring();
+  size_t contiguous;
+  const int16_t *samples = audio_ring.peek(this->microphone_consumer_, &contiguous);
+  if (contiguous < this->new_samples_to_get_()) {
+    audio_ring.read(this->microphone_consumer_, this->preprocessor_audio_buffer_, this->new_samples_to_get_());
+    samples = this->preprocessor_audio_buffer_;
   }
 
   size_t num_samples_read;
-  struct FrontendOutput frontend_output = FrontendProcessSamples(
-      &this->frontend_state_, this->preprocessor_audio_buffer_, this->new_samples_to_get_(), &num_samples_read);
+  struct FrontendOutput frontend_output =
+      FrontendProcessSamples(&this->frontend_state_, samples, this->new_samples_to_get_(), &num_samples_read);
+  if (samples != this->preprocessor_audio_buffer_)
+    audio_ring.consume(this->microphone_consumer_, this->new_samples_to_get_());
 
   for (size_t i = 0; i < frontend_output.size; ++i) {
     // These scaling values are set to match the TFLite audio frontend int8 output.
@@ -397,7 +490,11 @@ bool MicroWakeWord::generate_features_for_window_(int8_t features[PREPROCESSOR_F
 
 void MicroWakeWord::reset_states_() {
   ESP_LOGD(TAG, "Resetting buffers and probabilities");
-  this->ring_buffer_->reset();
+  // Only called while the inference task is idle
+  this->feature_tail_.store(this->feature_head_.load());
+  this->inference_detected_.store(false);
+  this->microphone_->get_audio_ring().discard(this->microphone_consumer_);
+  this->reported_overruns_ = this->microphone_->get_audio_ring().get_overruns(this->microphone_consumer_);
   this->ignore_windows_ = -MIN_SLICES_BEFORE_DETECTION;
   for (auto &model : this->wake_word_models_) {
     model.reset_probabilities();
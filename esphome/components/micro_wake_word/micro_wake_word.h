@@ -7,9 +7,17 @@
 
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
-#include "esphome/core/ring_buffer.h"
 
 #include "esphome/components/microphone/microphone.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <memory>
 
 #include <frontend_util.h>
 
@@ -32,6 +40,9 @@ enum State {
 // The number of audio slices to process before accepting a positive detection
 static const uint8_t MIN_SLICES_BEFORE_DETECTION = 74;
 
+// The number of feature frames waiting for inference, 160 ms with a 10 ms feature step size
+static const uint32_t FEATURE_QUEUE_SIZE = 16;
+
 class MicroWakeWord : public Component {
  public:
   void setup() override;
@@ -58,13 +69,20 @@ class MicroWakeWord : public Component {
                      size_t tensor_arena_size);
 #endif
 
+#ifdef USE_SENSOR
+  void set_queue_depth_sensor(sensor::Sensor *queue_depth_sensor) { this->queue_depth_sensor_ = queue_depth_sensor; }
+  /// Reports the average inference time per feature frame of the model for wake_word, or of all models if empty.
+  void add_inference_time_sensor(sensor::Sensor *sensor, const std::string &wake_word);
+#endif
+
  protected:
   microphone::Microphone *microphone_{nullptr};
   Trigger<std::string> *wake_word_detected_trigger_ = new Trigger<std::string>();
   State state_{State::IDLE};
   HighFrequencyLoopRequester high_freq_;
 
-  std::unique_ptr<RingBuffer> ring_buffer_;
+  uint8_t microphone_consumer_{0};
+  uint32_t reported_overruns_{0};
 
   std::vector<WakeWordModel> wake_word_models_;
 
@@ -84,34 +102,59 @@ class MicroWakeWord : public Component {
 
   uint8_t features_step_size_;
 
-  // Stores audio read from the microphone before being added to the ring buffer.
-  int16_t *input_buffer_{nullptr};
-  // Stores audio to be fed into the audio frontend for generating features.
+  // Stores audio to be fed into the audio frontend when it wraps around the end of the microphone's buffer.
   int16_t *preprocessor_audio_buffer_{nullptr};
 
   bool detected_{false};
   std::string detected_wake_word_{""};
 
+  /* Feature frames are generated in the main loop and run through the models by the inference task, which runs on the
+   * other core. The queue is only written by the main loop and only read by the task.
+   */
+  TaskHandle_t inference_task_handle_{nullptr};
+  int8_t feature_queue_[FEATURE_QUEUE_SIZE][PREPROCESSOR_FEATURE_SIZE];
+  std::atomic<uint32_t> feature_head_{0};
+  std::atomic<uint32_t> feature_tail_{0};
+  /// Set by the main loop while the task may use the models.
+  std::atomic<bool> inference_enabled_{false};
+  /// Set by the task while it may be using the models.
+  std::atomic<bool> inference_busy_{false};
+  /// Set by the task when it found a wake word, which is then in detected_wake_word_.
+  std::atomic<bool> inference_detected_{false};
+#ifdef USE_MICRO_WAKE_WORD_VAD
+  std::atomic<uint32_t> vad_rejections_{0};
+  std::atomic<uint32_t> vad_inference_time_{0};
+#endif
+
+  /// Total inference time in microseconds of each wake word model, and the number of frames processed.
+  std::unique_ptr<std::atomic<uint32_t>[]> model_inference_time_;
+  std::atomic<uint32_t> inference_frames_{0};
+  uint32_t max_queue_depth_{0};
+#ifdef USE_SENSOR
+  struct InferenceTimeSensor {
+    sensor::Sensor *sensor;
+    std::string wake_word;
+    uint32_t last_time;
+  };
+  sensor::Sensor *queue_depth_sensor_{nullptr};
+  std::vector<InferenceTimeSensor> inference_time_sensors_;
+  uint32_t published_frames_{0};
+#endif
+
   void set_state_(State state);
 
-  /// @brief Tests if there are enough samples in the ring buffer to generate new features.
+  /// @brief Tests if the microphone recorded enough new samples to generate new features.
   /// @return True if enough samples, false otherwise.
   bool has_enough_samples_();
 
-  /** Reads audio from microphone into the ring buffer
-   *
-   * Audio data (16000 kHz with int16 samples) is read into the input_buffer_.
-   * Verifies the ring buffer has enough space for all audio data. If not, it logs
-   * a warning and resets the ring buffer entirely.
-   * @return Number of bytes written to the ring buffer
-   */
-  size_t read_microphone_();
+  /// @brief Logs a warning if audio was lost because detection fell too far behind the microphone.
+  void check_overruns_();
 
-  /// @brief Allocates memory for input_buffer_, preprocessor_audio_buffer_, and ring_buffer_
+  /// @brief Allocates memory for preprocessor_audio_buffer_
   /// @return True if successful, false otherwise
   bool allocate_buffers_();
 
-  /// @brief Frees memory allocated for input_buffer_ and preprocessor_audio_buffer_
+  /// @brief Frees memory allocated for preprocessor_audio_buffer_
   void deallocate_buffers_();
 
   /// @brief Loads streaming models and prepares the feature generation frontend
@@ -122,12 +165,19 @@ class MicroWakeWord : public Component {
   /// generation frontend.
   void unload_models_();
 
-  /** Performs inference with each configured model
-   *
-   * If enough audio samples are available, it will generate one slice of new features.
-   * It then loops through and performs inference with each of the loaded models.
-   */
-  void update_model_probabilities_();
+  /// @brief Generates features for all new audio samples and hands them to the inference task.
+  void queue_features_();
+
+  static void inference_task(void *params);
+
+  /// @brief Runs the queued feature frames through the models, in the inference task.
+  /// @return True if frames were processed and there may be more, false otherwise
+  bool process_queued_features_();
+
+  /// @brief Performs inference with each configured model on one slice of features.
+  void update_model_probabilities_(const int8_t features[PREPROCESSOR_FEATURE_SIZE]);
+
+  void publish_inference_stats_();
 
   /** Checks every model's recent probabilities to determine if the wake word has been predicted
    *
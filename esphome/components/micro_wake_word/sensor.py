@@ -0,0 +1,53 @@
+import esphome.codegen as cg
+from esphome.components import sensor
+import esphome.config_validation as cv
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_MILLISECOND,
+)
+
+from . import MicroWakeWord
+
+DEPENDENCIES = ["micro_wake_word"]
+
+CONF_MICRO_WAKE_WORD_ID = "micro_wake_word_id"
+CONF_INFERENCE_TIME = "inference_time"
+CONF_QUEUE_DEPTH = "queue_depth"
+CONF_WAKE_WORD = "wake_word"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_MICRO_WAKE_WORD_ID): cv.use_id(MicroWakeWord),
+        cv.Optional(CONF_QUEUE_DEPTH): sensor.sensor_schema(
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_INFERENCE_TIME): cv.ensure_list(
+            sensor.sensor_schema(
+                unit_of_measurement=UNIT_MILLISECOND,
+                icon=ICON_TIMER,
+                accuracy_decimals=1,
+                state_class=STATE_CLASS_MEASUREMENT,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ).extend(
+                {
+                    cv.Optional(CONF_WAKE_WORD, default=""): cv.string,
+                }
+            )
+        ),
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_MICRO_WAKE_WORD_ID])
+    if queue_depth_config := config.get(CONF_QUEUE_DEPTH):
+        sens = await sensor.new_sensor(queue_depth_config)
+        cg.add(parent.set_queue_depth_sensor(sens))
+    for inference_time_config in config.get(CONF_INFERENCE_TIME, []):
+        sens = await sensor.new_sensor(inference_time_config)
+        wake_word = inference_time_config[CONF_WAKE_WORD]
+        cg.add(parent.add_inference_time_sensor(sens, wake_word))
@@ -0,0 +1,112 @@
+#include "audio_ring.h"
+
+#include "esphome/core/helpers.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace microphone {
+
+bool AudioRing::allocate(size_t samples) {
+  if (this->buffer_ != nullptr)
+    return true;
+  // A power of two keeps the index of a position right when the position wraps around
+  size_t capacity = 1;
+  while (capacity < samples)
+    capacity <<= 1;
+  samples = capacity;
+  ExternalRAMAllocator<int16_t> allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
+  this->buffer_ = allocator.allocate(samples);
+  if (this->buffer_ == nullptr)
+    return false;
+  this->capacity_ = samples;
+  return true;
+}
+
+void AudioRing::deallocate() {
+  if (this->buffer_ == nullptr)
+    return;
+  ExternalRAMAllocator<int16_t> allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
+  allocator.deallocate(this->buffer_, this->capacity_);
+  this->buffer_ = nullptr;
+  this->capacity_ = 0;
+  for (auto &consumer : this->consumers_)
+    consumer.position = this->written_;
+}
+
+uint8_t AudioRing::add_consumer() {
+  this->consumers_.push_back(Consumer{this->written_, 0, false});
+  return this->consumers_.size() - 1;
+}
+
+bool AudioRing::has_active_consumers() const {
+  return std::any_of(this->consumers_.begin(), this->consumers_.end(),
+                     [](const Consumer &consumer) { return consumer.active; });
+}
+
+void AudioRing::start_reading(uint8_t consumer) {
+  this->consumers_[consumer].active = true;
+  this->consumers_[consumer].position = this->written_;
+}
+
+void AudioRing::stop_reading(uint8_t consumer) { this->consumers_[consumer].active = false; }
+
+void AudioRing::discard(uint8_t consumer) { this->consumers_[consumer].position = this->written_; }
+
+size_t AudioRing::available(uint8_t consumer) const { return this->written_ - this->consumers_[consumer].position; }
+
+const int16_t *AudioRing::peek(uint8_t consumer, size_t *samples) const {
+  size_t available = this->available(consumer);
+  if (available == 0) {
+    *samples = 0;
+    return nullptr;
+  }
+  size_t index = this->consumers_[consumer].position % this->capacity_;
+  *samples = std::min(available, this->capacity_ - index);
+  return this->buffer_ + index;
+}
+
+void AudioRing::consume(uint8_t consumer, size_t samples) {
+  this->consumers_[consumer].position += std::min(samples, this->available(consumer));
+}
+
+size_t AudioRing::read(uint8_t consumer, int16_t *dst, size_t samples) {
+  size_t copied = 0;
+  while (copied < samples) {
+    size_t contiguous;
+    const int16_t *src = this->peek(consumer, &contiguous);
+    if (contiguous == 0)
+      break;
+    contiguous = std::min(contiguous, samples - copied);
+    memcpy(dst + copied, src, contiguous * sizeof(int16_t));
+    this->consume(consumer, contiguous);
+    copied += contiguous;
+  }
+  return copied;
+}
+
+int16_t *AudioRing::write_region(size_t *samples) {
+  if (this->buffer_ == nullptr) {
+    *samples = 0;
+    return nullptr;
+  }
+  size_t index = this->written_ % this->capacity_;
+  *samples = this->capacity_ - index;
+  return this->buffer_ + index;
+}
+
+void AudioRing::commit(size_t samples) {
+  this->written_ += samples;
+  // Consumers whose oldest unread samples were just overwritten move on to the oldest ones left
+  for (auto &consumer : this->consumers_) {
+    if (this->written_ - consumer.position <= this->capacity_)
+      continue;
+    consumer.position = this->written_ - this->capacity_;
+    if (consumer.active)
+      consumer.overruns++;
+  }
+}
+
+}  // namespace microphone
+}  // namespace esphome
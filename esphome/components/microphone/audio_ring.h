@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace microphone {
+
+/** Holds the most recent samples of a microphone for all components reading from it.
+ *
+ * The microphone writes each chunk once and every consumer (wake word detection, voice assistant, ...) keeps its own
+ * read position into the same buffer, so no consumer needs a copy of the audio. Samples are read in place with peek()
+ * and consume().
+ *
+ * The microphone never waits for consumers: when a consumer falls more than a buffer behind, its oldest samples are
+ * overwritten, it continues with the oldest samples still available and the overrun is counted.
+ *
+ * All methods must be called from the main loop, and pointers returned by peek() are only valid until the microphone
+ * writes again.
+ */
+class AudioRing {
+ public:
+  /// Allocate room for at least the given number of samples, if not already done. Returns false if out of memory.
+  bool allocate(size_t samples);
+  /// Free the buffer. Samples the consumers haven't read yet are dropped.
+  void deallocate();
+  bool is_allocated() const { return this->buffer_ != nullptr; }
+
+  /// Register a consumer, returns the id to pass to the other consumer methods.
+  uint8_t add_consumer();
+  bool has_consumers() const { return !this->consumers_.empty(); }
+  /// Whether any consumer is currently reading, which is when the microphone needs to write.
+  bool has_active_consumers() const;
+
+  /// Start reading at the next samples written. Samples written while a consumer is stopped are never seen by it.
+  void start_reading(uint8_t consumer);
+  void stop_reading(uint8_t consumer);
+  /// Skip everything written so far.
+  void discard(uint8_t consumer);
+
+  /// The number of samples the consumer hasn't read yet.
+  size_t available(uint8_t consumer) const;
+  /// Returns the unread samples in one piece, which may be less than available() when they wrap around the end.
+  const int16_t *peek(uint8_t consumer, size_t *samples) const;
+  void consume(uint8_t consumer, size_t samples);
+  /// Copy up to samples unread samples to dst and consume them, returns the number of samples copied.
+  size_t read(uint8_t consumer, int16_t *dst, size_t samples);
+  /// How often the consumer was too slow and lost samples.
+  uint32_t get_overruns(uint8_t consumer) const { return this->consumers_[consumer].overruns; }
+
+  /// Returns where the microphone writes the next samples, and in samples how much room there is in one piece.
+  int16_t *write_region(size_t *samples);
+  /// Mark samples written to the region returned by write_region() as readable.
+  void commit(size_t samples);
+
+ protected:
+  struct Consumer {
+    /// Positions count samples since the start, so the distance between them is correct even after wrapping.
+    uint32_t position;
+    uint32_t overruns;
+    bool active;
+  };
+
+  int16_t *buffer_{nullptr};
+  size_t capacity_{0};
+  uint32_t written_{0};
+  std::vector<Consumer> consumers_;
+};
+
+}  // namespace microphone
+}  // namespace esphome
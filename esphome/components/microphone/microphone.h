@@ -6,6 +6,8 @@
 #include <vector>
 #include "esphome/core/helpers.h"
 
+#include "audio_ring.h"
+
 namespace esphome {
 namespace microphone {
 
@@ -24,12 +26,18 @@ class Microphone {
     this->data_callbacks_.add(std::move(data_callback));
   }
   virtual size_t read(int16_t *buf, size_t len) = 0;
+  /// The recorded samples, shared by all components reading from this microphone.
+  AudioRing &get_audio_ring() { return this->audio_ring_; }
 
   bool is_running() const { return this->state_ == STATE_RUNNING; }
   bool is_stopped() const { return this->state_ == STATE_STOPPED; }
 
  protected:
+  /// 512 ms at 16 kHz, so consumers can fall behind for a while, e.g. while the voice assistant pipeline starts
+  static const size_t AUDIO_RING_SAMPLES = 8192;
+
   State state_{STATE_STOPPED};
+  AudioRing audio_ring_;
 
   CallbackManager<void(const std::vector<int16_t> &)> data_callbacks_{};
 };
@@ -2,40 +2,72 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
 namespace esphome {
 namespace modbus {
 
 static const char *const TAG = "modbus";
 
+// Received bytes are handed over by the UART within this many character times, see UARTComponent::set_rx_latency()
+static const uint8_t RX_LATENCY_SYMBOLS = 2;
+// Timeout for incomplete frames when the UART can't report gaps in the data in time
+static const uint32_t FALLBACK_FRAME_GAP_US = 50000;
+
 void Modbus::setup() {
   if (this->flow_control_pin_ != nullptr) {
     this->flow_control_pin_->setup();
   }
+
+  // Frames are separated by at least 3.5 character times of silence, a fixed 1750 us above 19200 baud
+  uint32_t baud_rate = std::max<uint32_t>(this->parent_->get_baud_rate(), 1);
+  uint32_t bits = 1 + this->parent_->get_data_bits() + this->parent_->get_stop_bits() +
+                  (this->parent_->get_parity() != uart::UART_CONFIG_PARITY_NONE ? 1 : 0);
+  uint32_t char_us = bits * 1000000UL / baud_rate;
+  uint32_t frame_gap_us = baud_rate > 19200 ? 1750 : char_us * 7 / 2;
+  if (this->parent_->set_rx_latency(RX_LATENCY_SYMBOLS)) {
+    this->frame_gap_us_ = frame_gap_us + RX_LATENCY_SYMBOLS * char_us;
+  } else {
+    // Received bytes may be held back longer than the gap, so a pause in the data doesn't mean the frame ended
+    this->frame_gap_us_ = std::max(frame_gap_us, FALLBACK_FRAME_GAP_US);
+  }
+
+#ifdef USE_SENSOR
+  if (this->response_time_sensor_ != nullptr || this->frames_sensor_ != nullptr ||
+      this->crc_errors_sensor_ != nullptr)
+    this->set_interval("frame_stats", 60000, [this]() { this->publish_frame_stats_(); });
+#endif
 }
 void Modbus::loop() {
   const uint32_t now = millis();
-
-  while (this->available()) {
-    uint8_t byte;
-    this->read_byte(&byte);
-    if (this->parse_modbus_byte_(byte)) {
-      this->last_modbus_byte_ = now;
-    } else {
-      size_t at = this->rx_buffer_.size();
-      if (at > 0) {
-        ESP_LOGV(TAG, "Clearing buffer of %d bytes - parse failed", at);
-        this->rx_buffer_.clear();
+  const uint32_t now_us = micros();
+
+  int available = this->available();
+  if (available > 0) {
+    this->last_modbus_byte_ = now;
+    this->last_rx_us_ = now_us;
+    // Read everything that arrived in as few calls as possible, and only look at frames once a batch is in
+    while (available > 0) {
+      if (this->rx_length_ == MAX_FRAME_SIZE) {
+        ESP_LOGV(TAG, "Clearing buffer of %u bytes - frame too long", this->rx_length_);
+        this->drop_frame_();
       }
+      size_t len = std::min<size_t>(available, MAX_FRAME_SIZE - this->rx_length_);
+      if (!this->read_array(this->rx_buffer_ + this->rx_length_, len))
+        break;
+      this->rx_length_ += len;
+      available -= len;
+      this->parse_frames_();
     }
+  } else if (this->rx_length_ > 0 && now_us - this->last_rx_us_ > this->frame_gap_us_) {
+    // The line went silent, so the rest of this frame is never going to arrive
+    ESP_LOGV(TAG, "Clearing buffer of %u bytes - timeout", this->rx_length_);
+    this->drop_frame_();
   }
 
   if (now - this->last_modbus_byte_ > 50) {
-    size_t at = this->rx_buffer_.size();
-    if (at > 0) {
-      ESP_LOGV(TAG, "Clearing buffer of %d bytes - timeout", at);
-      this->rx_buffer_.clear();
-    }
-
     // stop blocking new send commands after sent_wait_time_ ms after response received
     if (now - this->last_send_ > send_wait_time_) {
       if (waiting_for_response > 0) {
@@ -46,88 +78,90 @@ void Modbus::loop() {
   }
 }
 
-bool Modbus::parse_modbus_byte_(uint8_t byte) {
-  size_t at = this->rx_buffer_.size();
-  this->rx_buffer_.push_back(byte);
-  const uint8_t *raw = &this->rx_buffer_[0];
-  ESP_LOGVV(TAG, "Modbus received Byte  %d (0X%x)", byte, byte);
-  // Byte 0: modbus address (match all)
-  if (at == 0)
-    return true;
-  uint8_t address = raw[0];
-  uint8_t function_code = raw[1];
+void Modbus::parse_frames_() {
+  // Byte 0: modbus address (match all), byte 1: function code
   // Byte 2: Size (with modbus rtu function code 4/3)
   // See also https://en.wikipedia.org/wiki/Modbus
-  if (at == 2)
-    return true;
+  while (this->rx_length_ >= 3) {
+    const uint8_t *raw = this->rx_buffer_;
+    uint8_t function_code = raw[1];
+    size_t data_len = raw[2];
+    size_t data_offset = 3;
+
+    // Per https://modbus.org/docs/Modbus_Application_Protocol_V1_1b3.pdf Ch 5 User-Defined function codes
+    if (((function_code >= 65) && (function_code <= 72)) || ((function_code >= 100) && (function_code <= 110))) {
+      // Handle user-defined function, since we don't know how big this ought to be, all bytes received so far are
+      // taken as the frame once they end with a matching CRC. The CRC is checked once per batch of received bytes
+      // instead of for every byte, with the UART handing over bytes at the end of a frame that is usually once.
+      data_offset = 1;
+      data_len = this->rx_length_ - 3;
+      uint16_t computed_crc = crc16(raw, data_offset + data_len);
+      uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
+      if (computed_crc != remote_crc)
+        return;
+
+      ESP_LOGD(TAG, "Modbus user-defined function %02X found", function_code);
 
-  uint8_t data_len = raw[2];
-  uint8_t data_offset = 3;
-
-  // Per https://modbus.org/docs/Modbus_Application_Protocol_V1_1b3.pdf Ch 5 User-Defined function codes
-  if (((function_code >= 65) && (function_code <= 72)) || ((function_code >= 100) && (function_code <= 110))) {
-    // Handle user-defined function, since we don't know how big this ought to be,
-    // ideally we should delegate the entire length detection to whatever handler is
-    // installed, but wait, there is the CRC, and if we get a hit there is a good
-    // chance that this is a complete message ... admittedly there is a small chance is
-    // isn't but that is quite small given the purpose of the CRC in the first place
-
-    // Fewer than 2 bytes can't calc CRC
-    if (at < 2)
-      return true;
-
-    data_len = at - 2;
-    data_offset = 1;
-
-    uint16_t computed_crc = crc16(raw, data_offset + data_len);
-    uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
-
-    if (computed_crc != remote_crc)
-      return true;
+    } else {
+      // data starts at 2 and length is 4 for read registers commands
+      if (this->role == ModbusRole::SERVER && (function_code == 0x3 || function_code == 0x4)) {
+        data_offset = 2;
+        data_len = 4;
+      }
 
-    ESP_LOGD(TAG, "Modbus user-defined function %02X found", function_code);
+      // the response for write command mirrors the requests and data starts at offset 2 instead of 3 for read commands
+      if (function_code == 0x5 || function_code == 0x06 || function_code == 0xF || function_code == 0x10) {
+        data_offset = 2;
+        data_len = 4;
+      }
 
-  } else {
-    // data starts at 2 and length is 4 for read registers commands
-    if (this->role == ModbusRole::SERVER && (function_code == 0x3 || function_code == 0x4)) {
-      data_offset = 2;
-      data_len = 4;
-    }
+      // Error ( msb indicates error )
+      // response format:  Byte[0] = device address, Byte[1] function code | 0x80 , Byte[2] exception code,
+      // Byte[3-4] crc
+      if ((function_code & 0x80) == 0x80) {
+        data_offset = 2;
+        data_len = 1;
+      }
 
-    // the response for write command mirrors the requests and data starts at offset 2 instead of 3 for read commands
-    if (function_code == 0x5 || function_code == 0x06 || function_code == 0xF || function_code == 0x10) {
-      data_offset = 2;
-      data_len = 4;
-    }
+      // Byte data_offset..data_offset+data_len-1: Data, then CRC_LO and CRC_HI (over all bytes)
+      if (this->rx_length_ < data_offset + data_len + 2)
+        return;
 
-    // Error ( msb indicates error )
-    // response format:  Byte[0] = device address, Byte[1] function code | 0x80 , Byte[2] exception code, Byte[3-4] crc
-    if ((function_code & 0x80) == 0x80) {
-      data_offset = 2;
-      data_len = 1;
+      uint16_t computed_crc = crc16(raw, data_offset + data_len);
+      uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
+      if (computed_crc != remote_crc) {
+        this->frame_stats_.crc_errors++;
+        if (this->disable_crc_) {
+          ESP_LOGD(TAG, "Modbus CRC Check failed, but ignored! %02X!=%02X", computed_crc, remote_crc);
+        } else {
+          ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", computed_crc, remote_crc);
+          ESP_LOGV(TAG, "Clearing buffer of %u bytes - parse failed", this->rx_length_);
+          this->drop_frame_();
+          return;
+        }
+      }
     }
 
-    // Byte data_offset..data_offset+data_len-1: Data
-    if (at < data_offset + data_len)
-      return true;
+    this->handle_frame_(data_offset, data_len);
+    this->remove_frame_(data_offset + data_len + 2);
+  }
+}
 
-    // Byte 3+data_len: CRC_LO (over all bytes)
-    if (at == data_offset + data_len)
-      return true;
+void Modbus::handle_frame_(uint8_t data_offset, uint8_t data_len) {
+  const uint8_t *raw = this->rx_buffer_;
+  uint8_t address = raw[0];
+  uint8_t function_code = raw[1];
 
-    // Byte data_offset+len+1: CRC_HI (over all bytes)
-    uint16_t computed_crc = crc16(raw, data_offset + data_len);
-    uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
-    if (computed_crc != remote_crc) {
-      if (this->disable_crc_) {
-        ESP_LOGD(TAG, "Modbus CRC Check failed, but ignored! %02X!=%02X", computed_crc, remote_crc);
-      } else {
-        ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", computed_crc, remote_crc);
-        return false;
-      }
-    }
+  this->frame_stats_.frames++;
+  if (waiting_for_response != 0 && waiting_for_response == address) {
+    uint32_t response_time = micros() - this->last_send_us_;
+    this->frame_stats_.responses++;
+    this->frame_stats_.response_time_total_us += response_time;
+    this->frame_stats_.response_time_max_us = std::max(this->frame_stats_.response_time_max_us, response_time);
   }
-  std::vector<uint8_t> data(this->rx_buffer_.begin() + data_offset, this->rx_buffer_.begin() + data_offset + data_len);
+
+  this->frame_data_.assign(raw + data_offset, raw + data_offset + data_len);
+  const std::vector<uint8_t> &data = this->frame_data_;
   bool found = false;
   for (auto *device : this->devices_) {
     if (device->address_ == address) {
@@ -154,11 +188,44 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
   if (!found) {
     ESP_LOGW(TAG, "Got Modbus frame from unknown address 0x%02X! ", address);
   }
+}
 
-  // reset buffer
-  ESP_LOGV(TAG, "Clearing buffer of %d bytes - parse succeeded", at);
-  this->rx_buffer_.clear();
-  return true;
+void Modbus::remove_frame_(size_t size) {
+  ESP_LOGV(TAG, "Clearing %zu of %u buffered bytes - parse succeeded", size, this->rx_length_);
+  this->rx_length_ -= size;
+  // Anything after the frame was received without a gap, which only happens when frames are sent back to back
+  if (this->rx_length_ > 0)
+    memmove(this->rx_buffer_, this->rx_buffer_ + size, this->rx_length_);
+}
+
+void Modbus::drop_frame_() {
+  this->frame_stats_.dropped_bytes += this->rx_length_;
+  this->rx_length_ = 0;
+}
+
+void Modbus::sent_() {
+  this->last_send_ = millis();
+  this->last_send_us_ = micros();
+}
+
+void Modbus::publish_frame_stats_() {
+#ifdef USE_SENSOR
+  const ModbusFrameStats &stats = this->frame_stats_;
+  if (this->response_time_sensor_ != nullptr) {
+    // Average of the responses since the last update, in milliseconds
+    uint32_t responses = stats.responses - this->published_responses_;
+    if (responses > 0) {
+      uint64_t response_time = stats.response_time_total_us - this->published_response_time_us_;
+      this->response_time_sensor_->publish_state(response_time / 1000.0f / responses);
+    }
+  }
+  this->published_responses_ = stats.responses;
+  this->published_response_time_us_ = stats.response_time_total_us;
+  if (this->frames_sensor_ != nullptr)
+    this->frames_sensor_->publish_state(stats.frames);
+  if (this->crc_errors_sensor_ != nullptr)
+    this->crc_errors_sensor_->publish_state(stats.crc_errors);
+#endif
 }
 
 void Modbus::dump_config() {
@@ -166,6 +233,12 @@ void Modbus::dump_config() {
   LOG_PIN("  Flow Control Pin: ", this->flow_control_pin_);
   ESP_LOGCONFIG(TAG, "  Send Wait Time: %d ms", this->send_wait_time_);
   ESP_LOGCONFIG(TAG, "  CRC Disabled: %s", YESNO(this->disable_crc_));
+  ESP_LOGCONFIG(TAG, "  Frame Gap: %" PRIu32 " us", this->frame_gap_us_);
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Response Time", this->response_time_sensor_);
+  LOG_SENSOR("  ", "Frames", this->frames_sensor_);
+  LOG_SENSOR("  ", "CRC Errors", this->crc_errors_sensor_);
+#endif
 }
 float Modbus::get_setup_priority() const {
   // After UART bus
@@ -219,7 +292,7 @@ void Modbus::send(uint8_t address, uint8_t function_code, uint16_t start_address
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
   waiting_for_response = address;
-  last_send_ = millis();
+  this->sent_();
   ESP_LOGV(TAG, "Modbus write: %s", format_hex_pretty(data).c_str());
 }
 
@@ -242,7 +315,7 @@ void Modbus::send_raw(const std::vector<uint8_t> &payload) {
     this->flow_control_pin_->digital_write(false);
   waiting_for_response = payload[0];
   ESP_LOGV(TAG, "Modbus write raw: %s", format_hex_pretty(payload).c_str());
-  last_send_ = millis();
+  this->sent_();
 }
 
 }  // namespace modbus
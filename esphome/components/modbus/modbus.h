@@ -1,7 +1,11 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/components/uart/uart.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
 
 #include <vector>
 
@@ -15,6 +19,19 @@ enum ModbusRole {
 
 class ModbusDevice;
 
+/// Counters of the frames received on the bus since boot.
+struct ModbusFrameStats {
+  /// Frames that were handled, including those with an ignored CRC error.
+  uint32_t frames{0};
+  uint32_t crc_errors{0};
+  /// Bytes thrown away because they didn't form a complete frame.
+  uint32_t dropped_bytes{0};
+  /// Responses to a request sent by us, and the time from the end of the request until the response was received.
+  uint32_t responses{0};
+  uint64_t response_time_total_us{0};
+  uint32_t response_time_max_us{0};
+};
+
 class Modbus : public uart::UARTDevice, public Component {
  public:
   Modbus() = default;
@@ -37,19 +54,52 @@ class Modbus : public uart::UARTDevice, public Component {
   uint8_t waiting_for_response{0};
   void set_send_wait_time(uint16_t time_in_ms) { send_wait_time_ = time_in_ms; }
   void set_disable_crc(bool disable_crc) { disable_crc_ = disable_crc; }
+  const ModbusFrameStats &get_frame_stats() const { return this->frame_stats_; }
+#ifdef USE_SENSOR
+  void set_response_time_sensor(sensor::Sensor *sensor) { this->response_time_sensor_ = sensor; }
+  void set_frames_sensor(sensor::Sensor *sensor) { this->frames_sensor_ = sensor; }
+  void set_crc_errors_sensor(sensor::Sensor *sensor) { this->crc_errors_sensor_ = sensor; }
+#endif
 
   ModbusRole role;
 
+  /// A Modbus RTU frame (address, PDU and CRC) has at most 256 bytes.
+  static const uint16_t MAX_FRAME_SIZE = 256;
+
  protected:
   GPIOPin *flow_control_pin_{nullptr};
 
-  bool parse_modbus_byte_(uint8_t byte);
+  /// Handle all complete frames at the start of rx_buffer_.
+  void parse_frames_();
+  void handle_frame_(uint8_t data_offset, uint8_t data_len);
+  /// Remove the first size bytes of rx_buffer_.
+  void remove_frame_(size_t size);
+  void drop_frame_();
+  void sent_();
+  void publish_frame_stats_();
+
   uint16_t send_wait_time_{250};
   bool disable_crc_;
-  std::vector<uint8_t> rx_buffer_;
+  /// Received bytes are read into this buffer in batches and frames are handled in place.
+  uint8_t rx_buffer_[MAX_FRAME_SIZE];
+  uint16_t rx_length_{0};
+  /// Silence after which a frame is considered complete, so anything left of it is dropped.
+  uint32_t frame_gap_us_{0};
+  uint32_t last_rx_us_{0};
   uint32_t last_modbus_byte_{0};
   uint32_t last_send_{0};
+  uint32_t last_send_us_{0};
+  /// Data of the frame passed to on_modbus_data(), kept to reuse its memory.
+  std::vector<uint8_t> frame_data_;
   std::vector<ModbusDevice *> devices_;
+  ModbusFrameStats frame_stats_;
+#ifdef USE_SENSOR
+  sensor::Sensor *response_time_sensor_{nullptr};
+  sensor::Sensor *frames_sensor_{nullptr};
+  sensor::Sensor *crc_errors_sensor_{nullptr};
+  uint32_t published_responses_{0};
+  uint64_t published_response_time_us_{0};
+#endif
 };
 
 class ModbusDevice {
@@ -0,0 +1,54 @@
+import esphome.codegen as cg
+from esphome.components import sensor
+import esphome.config_validation as cv
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
+)
+
+from . import CONF_MODBUS_ID, Modbus
+
+DEPENDENCIES = ["modbus"]
+
+CONF_CRC_ERRORS = "crc_errors"
+CONF_FRAMES = "frames"
+CONF_RESPONSE_TIME = "response_time"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_MODBUS_ID): cv.use_id(Modbus),
+        cv.Optional(CONF_RESPONSE_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_FRAMES): sensor.sensor_schema(
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_CRC_ERRORS): sensor.sensor_schema(
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_MODBUS_ID])
+    if response_time_config := config.get(CONF_RESPONSE_TIME):
+        sens = await sensor.new_sensor(response_time_config)
+        cg.add(parent.set_response_time_sensor(sens))
+    if frames_config := config.get(CONF_FRAMES):
+        sens = await sensor.new_sensor(frames_config)
+        cg.add(parent.set_frames_sensor(sens))
+    if crc_errors_config := config.get(CONF_CRC_ERRORS):
+        sens = await sensor.new_sensor(crc_errors_config)
+        cg.add(parent.set_crc_errors_sensor(sens))
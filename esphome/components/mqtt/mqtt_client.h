@@ -17,6 +17,7 @@
 #include "mqtt_backend_libretiny.h"
 #endif
 #include "lwip/ip_addr.h"
+#include "mqtt_topic_trie.h"
 
 #include <vector>
 
@@ -314,6 +315,8 @@ class MQTTClientComponent : public Component {
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  MQTTTopicTrie subscription_trie_;
+  std::vector<uint16_t> topic_matches_;
 #if defined(USE_ESP32)
   MQTTBackendESP32 mqtt_backend_;
 #elif defined(USE_ESP8266)
@@ -0,0 +1,116 @@
+#include "mqtt_topic_trie.h"
+
+#ifdef USE_MQTT
+
+#include <cstring>
+
+namespace esphome {
+namespace mqtt {
+
+void MQTTTopicTrie::clear() {
+  this->nodes_.clear();
+  this->levels_.clear();
+  this->next_id_.clear();
+  // The root node stands for the level before the first one of every topic
+  this->nodes_.push_back(Node{0, 0});
+}
+
+void MQTTTopicTrie::add(const std::string &filter, uint16_t id) {
+  if (this->next_id_.size() <= id)
+    this->next_id_.resize(id + 1, int16_t(NONE));
+
+  int16_t node = 0;
+  const char *level = filter.c_str();
+  while (true) {
+    const char *end = strchr(level, '/');
+    size_t length = end == nullptr ? strlen(level) : end - level;
+    if (length == 1 && *level == '#') {
+      // '#' matches everything below the current node, any levels after it are invalid
+      this->add_id_(this->nodes_[node].first_multi_id, id);
+      return;
+    }
+    node = this->find_or_add_child_(node, level, length);
+    if (end == nullptr)
+      break;
+    level = end + 1;
+  }
+  this->add_id_(this->nodes_[node].first_id, id);
+}
+
+int16_t MQTTTopicTrie::find_or_add_child_(int16_t parent, const char *level, size_t length) {
+  if (length == 1 && *level == '+') {
+    if (this->nodes_[parent].single_wildcard == NONE) {
+      this->nodes_.push_back(Node{0, 0});
+      this->nodes_[parent].single_wildcard = this->nodes_.size() - 1;
+    }
+    return this->nodes_[parent].single_wildcard;
+  }
+
+  for (int16_t child = this->nodes_[parent].first_child; child != NONE; child = this->nodes_[child].next_sibling) {
+    const Node &node = this->nodes_[child];
+    if (node.level_length == length && memcmp(this->levels_.data() + node.level_start, level, length) == 0)
+      return child;
+  }
+  Node node{static_cast<uint16_t>(this->levels_.size()), static_cast<uint16_t>(length)};
+  node.next_sibling = this->nodes_[parent].first_child;
+  this->levels_.append(level, length);
+  this->nodes_.push_back(node);
+  this->nodes_[parent].first_child = this->nodes_.size() - 1;
+  return this->nodes_[parent].first_child;
+}
+
+void MQTTTopicTrie::add_id_(int16_t &list, uint16_t id) {
+  // Appended at the end, so ids of the same filter come out in the order they were added
+  int16_t *next = &list;
+  while (*next != NONE)
+    next = &this->next_id_[*next];
+  *next = id;
+  this->next_id_[id] = NONE;
+}
+
+void MQTTTopicTrie::add_ids_(int16_t list, std::vector<uint16_t> &matches) const {
+  for (int16_t id = list; id != NONE; id = this->next_id_[id])
+    matches.push_back(id);
+}
+
+void MQTTTopicTrie::match(const char *topic, std::vector<uint16_t> &matches) const {
+  this->match_(0, topic, *topic != '\0' && *topic != '$', matches);
+}
+
+void MQTTTopicTrie::match_(int16_t node, const char *level, bool wildcards, std::vector<uint16_t> &matches) const {
+  const Node &parent = this->nodes_[node];
+  // '#' needs at least one more character of the topic to match
+  if (wildcards && *level != '\0')
+    this->add_ids_(parent.first_multi_id, matches);
+
+  const char *end = strchr(level, '/');
+  const bool last = end == nullptr;
+  size_t length = last ? strlen(level) : end - level;
+
+  for (int16_t child = parent.first_child; child != NONE; child = this->nodes_[child].next_sibling) {
+    const Node &candidate = this->nodes_[child];
+    if (candidate.level_length != length || memcmp(this->levels_.data() + candidate.level_start, level, length) != 0)
+      continue;
+    if (last) {
+      this->add_ids_(candidate.first_id, matches);
+    } else {
+      this->match_(child, end + 1, true, matches);
+    }
+    // Levels are unique among siblings
+    break;
+  }
+
+  // '+' matches an empty level, except at the end of the topic
+  if (wildcards && parent.single_wildcard != NONE && !(last && length == 0)) {
+    if (last) {
+      this->add_ids_(this->nodes_[parent.single_wildcard].first_id, matches);
+    } else {
+      this->match_(parent.single_wildcard, end + 1, true, matches);
+    }
+  }
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/** Finds the subscriptions whose topic filter matches the topic of a received message.
+ *
+ * The filters are split into levels at each '/' and stored as a tree that shares common prefixes, with separate
+ * children for the '+' and '#' wildcards. A message only walks the levels of its own topic, instead of being compared
+ * with every filter character by character.
+ *
+ * Like the MQTT spec requires, wildcards in the first level don't match topics starting with '$'.
+ */
+class MQTTTopicTrie {
+ public:
+  MQTTTopicTrie() { this->clear(); }
+
+  /// Add a topic filter, identified by id in the results of match().
+  void add(const std::string &filter, uint16_t id);
+  /// Remove all filters.
+  void clear();
+  /// Append the ids of all filters matching topic to matches, in no particular order.
+  void match(const char *topic, std::vector<uint16_t> &matches) const;
+
+ protected:
+  static constexpr int16_t NONE = -1;
+
+  struct Node {
+    /// The literal level of this node, stored in levels_.
+    uint16_t level_start;
+    uint16_t level_length;
+    int16_t first_child{NONE};
+    int16_t next_sibling{NONE};
+    /// The child for a '+' level.
+    int16_t single_wildcard{NONE};
+    /// First filter ending at this node, and first filter continuing with a '#' level after it.
+    int16_t first_id{NONE};
+    int16_t first_multi_id{NONE};
+  };
+
+  int16_t find_or_add_child_(int16_t parent, const char *level, size_t length);
+  void add_id_(int16_t &list, uint16_t id);
+  void add_ids_(int16_t list, std::vector<uint16_t> &matches) const;
+  void match_(int16_t node, const char *level, bool wildcards, std::vector<uint16_t> &matches) const;
+
+  std::vector<Node> nodes_;
+  std::string levels_;
+  /// The next id in the same list, indexed by id.
+  std::vector<int16_t> next_id_;
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -47,8 +47,9 @@ class RemoteTransmitData {
 
 class RemoteReceiveData {
  public:
-  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode)
-      : data_(data), index_(0), tolerance_(tolerance), tolerance_mode_(tolerance_mode) {}
+  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode,
+                             uint32_t frame = 0)
+      : data_(data), index_(0), tolerance_(tolerance), tolerance_mode_(tolerance_mode), frame_(frame) {}
 
   const RawTimings &get_raw_data() const { return this->data_; }
   uint32_t get_index() const { return index_; }
@@ -76,6 +77,8 @@ class RemoteReceiveData {
   }
   uint32_t get_tolerance() { return tolerance_; }
   ToleranceMode get_tolerance_mode() { return this->tolerance_mode_; }
+  /// Identifies the received frame this data belongs to, 0 if unknown.
+  uint32_t get_frame() const { return this->frame_; }
 
  protected:
   int32_t lower_bound_(uint32_t length) const {
@@ -99,6 +102,7 @@ class RemoteReceiveData {
   uint32_t index_;
   uint32_t tolerance_;
   ToleranceMode tolerance_mode_;
+  uint32_t frame_;
 };
 
 class RemoteComponentBase {
@@ -216,14 +220,24 @@ class RemoteReceiverBase : public RemoteComponentBase {
   void call_listeners_();
   void call_dumpers_();
   void call_listeners_dumpers_() {
+    this->frame_ = ++next_frame_;
+    if (this->frame_ == 0)
+      this->frame_ = ++next_frame_;
     this->call_listeners_();
     this->call_dumpers_();
   }
+  RemoteReceiveData receive_data_() const {
+    return RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_, this->frame_);
+  }
+
+  /// Shared by all receivers, so a frame number never refers to frames of two receivers.
+  static uint32_t next_frame_;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
   std::vector<RemoteReceiverListener *> listeners_;
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
   RawTimings temp_;
+  uint32_t frame_{0};
   uint32_t tolerance_{25};
   ToleranceMode tolerance_mode_{TOLERANCE_MODE_PERCENTAGE};
 };
@@ -244,18 +258,38 @@ template<typename T> class RemoteProtocol {
  public:
   using ProtocolData = T;
   virtual void encode(RemoteTransmitData *dst, const ProtocolData &data) = 0;
+  /// Every received frame is offered to every protocol. Reject frames of other protocols by their header or first
+  /// timings before decoding any bits, so a configuration with many protocols stays cheap per frame.
   virtual optional<ProtocolData> decode(RemoteReceiveData src) = 0;
   virtual void dump(const ProtocolData &data) = 0;
 };
 
+/** Decodes received frames with protocol T at most once.
+ *
+ * Every binary sensor, trigger and dumper of a protocol is handed the same frame. Instead of each of them running the
+ * decoder over all timings again, the result for the last frame is kept and reused by the others, so adding more codes
+ * of a protocol no longer adds more decoding work per frame.
+ */
+template<typename T> class RemoteDecodeCache {
+ public:
+  static const optional<typename T::ProtocolData> &decode(RemoteReceiveData src) {
+    static uint32_t frame = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    static optional<typename T::ProtocolData> result;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    if (src.get_frame() == 0 || src.get_frame() != frame) {
+      result = T().decode(src);
+      frame = src.get_frame();
+    }
+    return result;
+  }
+};
+
 template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBinarySensorBase {
  public:
   RemoteReceiverBinarySensor() : RemoteReceiverBinarySensorBase() {}
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    const auto &res = RemoteDecodeCache<T>::decode(src);
     return res.has_value() && *res == this->data_;
   }
 
@@ -270,8 +304,7 @@ template<typename T>
 class RemoteReceiverTrigger : public Trigger<typename T::ProtocolData>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    const auto &res = RemoteDecodeCache<T>::decode(src);
     if (res.has_value()) {
       this->trigger(*res);
       return true;
@@ -312,11 +345,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public RemoteTransm
 template<typename T> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    const auto &decoded = RemoteDecodeCache<T>::decode(src);
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
@@ -2,6 +2,10 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+#include "esphome/core/application.h"
+#endif
+
 namespace esphome {
 namespace rotary_encoder {
 
@@ -126,6 +130,10 @@ void IRAM_ATTR HOT RotaryEncoderSensorStore::gpio_intr(RotaryEncoderSensorStore
   arg->first_read = false;
 
   arg->state = new_state;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  if (rotation_dir != 0)
+    App.wake_loop_isrsafe();
+#endif
 }
 
 void RotaryEncoderSensor::setup() {
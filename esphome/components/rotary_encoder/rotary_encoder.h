@@ -81,6 +81,10 @@ class RotaryEncoderSensor : public sensor::Sensor, public Component {
   void setup() override;
   void dump_config() override;
   void loop() override;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// Rotations wake the loop from the pin interrupt, only the index pin has to be polled.
+  bool needs_polling() const override { return this->pin_i_ != nullptr; }
+#endif
 
   float get_setup_priority() const override;
 
@@ -20,6 +20,10 @@ class SafeModeComponent : public Component {
   void dump_config() override;
   float get_setup_priority() const override;
   void loop() override;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// The boot-is-good check only needs second granularity, which the bounded event wait already provides.
+  bool needs_polling() const override { return false; }
+#endif
 
   void clean_rtc();
 
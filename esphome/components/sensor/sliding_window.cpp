@@ -0,0 +1,235 @@
+#include "sliding_window.h"
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace sensor {
+
+// SlidingWindowAverage
+SlidingWindowAverage::SlidingWindowAverage(size_t window_size) : values_(std::max<size_t>(window_size, 1)) {}
+void SlidingWindowAverage::set_window_size(size_t window_size) {
+  window_size = std::max<size_t>(window_size, 1);
+  size_t keep = std::min(this->size_, window_size);
+  std::vector<float> values(window_size);
+  for (size_t i = 0; i < keep; i++)
+    values[i] = this->values_[(this->next_ + this->values_.size() - keep + i) % this->values_.size()];
+  this->values_ = std::move(values);
+  this->size_ = keep;
+  this->next_ = keep % window_size;
+  this->recalculate_();
+}
+void SlidingWindowAverage::push(float value) {
+  if (this->size_ == this->values_.size()) {
+    float evicted = this->values_[this->next_];
+    if (!std::isnan(evicted)) {
+      this->sum_ -= evicted;
+      this->valid_count_--;
+    }
+  } else {
+    this->size_++;
+  }
+  this->values_[this->next_] = value;
+  if (!std::isnan(value)) {
+    this->sum_ += value;
+    this->valid_count_++;
+  }
+  if (++this->next_ == this->values_.size()) {
+    this->next_ = 0;
+    // Start over from the stored values once per window so rounding errors of the running sum don't add up
+    this->recalculate_();
+  }
+}
+float SlidingWindowAverage::average() const {
+  if (this->valid_count_ == 0)
+    return NAN;
+  return this->sum_ / this->valid_count_;
+}
+void SlidingWindowAverage::recalculate_() {
+  this->sum_ = 0.0f;
+  this->valid_count_ = 0;
+  for (size_t i = 0; i < this->size_; i++) {
+    float value = this->values_[i];
+    if (!std::isnan(value)) {
+      this->sum_ += value;
+      this->valid_count_++;
+    }
+  }
+}
+
+// SlidingWindowExtremum
+SlidingWindowExtremum::SlidingWindowExtremum(size_t window_size, bool maximum)
+    : entries_(std::max<size_t>(window_size, 1)), window_size_(std::max<size_t>(window_size, 1)), maximum_(maximum) {}
+void SlidingWindowExtremum::set_window_size(size_t window_size) {
+  this->window_size_ = std::max<size_t>(window_size, 1);
+  this->evict_();
+  // All remaining entries are part of the new window, so they fit
+  std::vector<Entry> entries(this->window_size_);
+  for (size_t i = 0; i < this->size_; i++)
+    entries[i] = this->at_(i);
+  this->entries_ = std::move(entries);
+  this->head_ = 0;
+}
+void SlidingWindowExtremum::push(float value) {
+  uint32_t index = this->index_++;
+  this->evict_();
+  if (std::isnan(value))
+    return;
+  // Values that can no longer become the extremum before leaving the window are dropped
+  while (this->size_ > 0) {
+    float back = this->at_(this->size_ - 1).value;
+    if (this->maximum_ ? back > value : back < value)
+      break;
+    this->size_--;
+  }
+  this->at_(this->size_) = Entry{index, value};
+  this->size_++;
+}
+float SlidingWindowExtremum::value() const {
+  if (this->size_ == 0)
+    return NAN;
+  return this->entries_[this->head_].value;
+}
+void SlidingWindowExtremum::evict_() {
+  while (this->size_ > 0 && this->index_ - this->at_(0).index > this->window_size_) {
+    this->head_ = (this->head_ + 1) % this->entries_.size();
+    this->size_--;
+  }
+}
+
+// SlidingWindowQuantile
+SlidingWindowQuantile::SlidingWindowQuantile(size_t window_size, float quantile)
+    : slots_(std::max<size_t>(window_size, 1), Slot{0.0f, 0, HEAP_NONE}), quantile_(quantile) {
+  this->low_.reserve(this->slots_.size());
+  this->high_.reserve(this->slots_.size());
+}
+void SlidingWindowQuantile::set_window_size(size_t window_size) {
+  window_size = std::max<size_t>(window_size, 1);
+  size_t keep = std::min(this->size_, window_size);
+  std::vector<float> values(keep);
+  for (size_t i = 0; i < keep; i++)
+    values[i] = this->slots_[(this->next_ + this->slots_.size() - keep + i) % this->slots_.size()].value;
+
+  this->slots_.assign(window_size, Slot{0.0f, 0, HEAP_NONE});
+  this->next_ = 0;
+  this->size_ = 0;
+  this->low_.clear();
+  this->high_.clear();
+  this->low_.reserve(window_size);
+  this->high_.reserve(window_size);
+  for (float value : values)
+    this->push(value);
+}
+void SlidingWindowQuantile::set_quantile(float quantile) {
+  this->quantile_ = quantile;
+  this->rebalance_();
+}
+void SlidingWindowQuantile::push(float value) {
+  uint32_t slot = this->next_;
+  if (this->size_ == this->slots_.size()) {
+    HeapId heap = this->slots_[slot].heap;
+    if (heap != HEAP_NONE)
+      this->heap_remove_(heap, this->slots_[slot].heap_pos);
+  } else {
+    this->size_++;
+  }
+  this->slots_[slot].value = value;
+  if (!std::isnan(value)) {
+    if (!this->low_.empty() && value <= this->slots_[this->low_[0]].value) {
+      this->heap_push_(HEAP_LOW, slot);
+    } else {
+      this->heap_push_(HEAP_HIGH, slot);
+    }
+  }
+  this->next_ = (this->next_ + 1) % this->slots_.size();
+  this->rebalance_();
+}
+float SlidingWindowQuantile::quantile() const {
+  if (this->low_.empty())
+    return NAN;
+  return this->slots_[this->low_[0]].value;
+}
+float SlidingWindowQuantile::median() const {
+  size_t count = this->low_.size() + this->high_.size();
+  if (count == 0)
+    return NAN;
+  float low = this->slots_[this->low_[0]].value;
+  if (count % 2)
+    return low;
+  return (low + this->slots_[this->high_[0]].value) / 2.0f;
+}
+bool SlidingWindowQuantile::before_(HeapId heap, uint32_t a, uint32_t b) const {
+  if (heap == HEAP_LOW)
+    return this->slots_[a].value > this->slots_[b].value;
+  return this->slots_[a].value < this->slots_[b].value;
+}
+void SlidingWindowQuantile::swap_(HeapId heap, uint32_t i, uint32_t j) {
+  auto &h = this->heap_(heap);
+  std::swap(h[i], h[j]);
+  this->slots_[h[i]].heap_pos = i;
+  this->slots_[h[j]].heap_pos = j;
+}
+void SlidingWindowQuantile::sift_up_(HeapId heap, uint32_t pos) {
+  auto &h = this->heap_(heap);
+  while (pos > 0) {
+    uint32_t parent = (pos - 1) / 2;
+    if (!this->before_(heap, h[pos], h[parent]))
+      return;
+    this->swap_(heap, pos, parent);
+    pos = parent;
+  }
+}
+void SlidingWindowQuantile::sift_down_(HeapId heap, uint32_t pos) {
+  auto &h = this->heap_(heap);
+  while (true) {
+    uint32_t best = pos;
+    uint32_t left = 2 * pos + 1;
+    uint32_t right = left + 1;
+    if (left < h.size() && this->before_(heap, h[left], h[best]))
+      best = left;
+    if (right < h.size() && this->before_(heap, h[right], h[best]))
+      best = right;
+    if (best == pos)
+      return;
+    this->swap_(heap, pos, best);
+    pos = best;
+  }
+}
+void SlidingWindowQuantile::heap_push_(HeapId heap, uint32_t slot) {
+  auto &h = this->heap_(heap);
+  h.push_back(slot);
+  this->slots_[slot].heap = heap;
+  this->slots_[slot].heap_pos = h.size() - 1;
+  this->sift_up_(heap, h.size() - 1);
+}
+void SlidingWindowQuantile::heap_remove_(HeapId heap, uint32_t pos) {
+  auto &h = this->heap_(heap);
+  uint32_t last = h.size() - 1;
+  this->slots_[h[pos]].heap = HEAP_NONE;
+  if (pos != last)
+    this->swap_(heap, pos, last);
+  h.pop_back();
+  if (pos < h.size()) {
+    this->sift_up_(heap, pos);
+    this->sift_down_(heap, pos);
+  }
+}
+void SlidingWindowQuantile::rebalance_() {
+  size_t count = this->low_.size() + this->high_.size();
+  size_t target = 0;
+  if (count > 0)
+    target = std::min(std::max<size_t>(ceilf(count * this->quantile_), 1), count);
+  // Moving the top of one heap to the other keeps every value in low_ <= every value in high_
+  while (this->low_.size() > target) {
+    uint32_t slot = this->low_[0];
+    this->heap_remove_(HEAP_LOW, 0);
+    this->heap_push_(HEAP_HIGH, slot);
+  }
+  while (this->low_.size() < target) {
+    uint32_t slot = this->high_[0];
+    this->heap_remove_(HEAP_HIGH, 0);
+    this->heap_push_(HEAP_LOW, slot);
+  }
+}
+
+}  // namespace sensor
+}  // namespace esphome
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace sensor {
+
+/** Running average over the last window_size values.
+ *
+ * Values are kept in a fixed-capacity ring buffer and the sum is updated as values enter and leave the window, so
+ * each new value costs O(1). NaN values take up a slot in the window but are not part of the average.
+ */
+class SlidingWindowAverage {
+ public:
+  explicit SlidingWindowAverage(size_t window_size);
+
+  /// Change the window size, keeping the newest values.
+  void set_window_size(size_t window_size);
+  void push(float value);
+  /// Average of the non-NaN values in the window, NaN if there are none.
+  float average() const;
+
+ protected:
+  void recalculate_();
+
+  std::vector<float> values_;
+  size_t next_{0};
+  size_t size_{0};
+  float sum_{0.0f};
+  size_t valid_count_{0};
+};
+
+/** Minimum or maximum over the last window_size values.
+ *
+ * Uses a monotonic deque stored in a fixed-capacity ring buffer: it only holds the values that can still become the
+ * extremum of the window, so each new value costs amortized O(1). NaN values are ignored.
+ */
+class SlidingWindowExtremum {
+ public:
+  SlidingWindowExtremum(size_t window_size, bool maximum);
+
+  /// Change the window size, keeping the newest values.
+  void set_window_size(size_t window_size);
+  void push(float value);
+  /// Extremum of the non-NaN values in the window, NaN if there are none.
+  float value() const;
+
+ protected:
+  struct Entry {
+    uint32_t index;
+    float value;
+  };
+
+  Entry &at_(size_t pos) { return this->entries_[(this->head_ + pos) % this->entries_.size()]; }
+  void evict_();
+
+  std::vector<Entry> entries_;
+  size_t head_{0};
+  size_t size_{0};
+  size_t window_size_;
+  /// Number of values pushed so far, wrapping around, used to tell when an entry leaves the window.
+  uint32_t index_{0};
+  bool maximum_;
+};
+
+/** Quantile over the last window_size values.
+ *
+ * The non-NaN values of the window are split over a max-heap holding the lowest ceil(n * quantile) values and a
+ * min-heap holding the rest, so the requested quantile is always at the top of the first heap. Every value in the
+ * fixed-capacity ring buffer knows its position in its heap, so the value leaving the window is removed in
+ * O(log n) and each new value costs O(log n) in total.
+ */
+class SlidingWindowQuantile {
+ public:
+  SlidingWindowQuantile(size_t window_size, float quantile);
+
+  /// Change the window size, keeping the newest values.
+  void set_window_size(size_t window_size);
+  void set_quantile(float quantile);
+  void push(float value);
+  /// Value at the configured quantile of the non-NaN values in the window, NaN if there are none.
+  float quantile() const;
+  /// Median of the non-NaN values in the window, averaging the two middle values if the count is even.
+  /// Requires a quantile of 0.5.
+  float median() const;
+
+ protected:
+  enum HeapId : uint8_t { HEAP_NONE, HEAP_LOW, HEAP_HIGH };
+
+  struct Slot {
+    float value;
+    uint32_t heap_pos;
+    HeapId heap;
+  };
+
+  std::vector<uint32_t> &heap_(HeapId heap) { return heap == HEAP_LOW ? this->low_ : this->high_; }
+  /// Whether slot a belongs closer to the top of heap than slot b.
+  bool before_(HeapId heap, uint32_t a, uint32_t b) const;
+  void swap_(HeapId heap, uint32_t i, uint32_t j);
+  void sift_up_(HeapId heap, uint32_t pos);
+  void sift_down_(HeapId heap, uint32_t pos);
+  void heap_push_(HeapId heap, uint32_t slot);
+  void heap_remove_(HeapId heap, uint32_t pos);
+  void rebalance_();
+
+  std::vector<Slot> slots_;
+  size_t next_{0};
+  size_t size_{0};
+  /// Max-heap of slot indices holding the lower part of the values.
+  std::vector<uint32_t> low_;
+  /// Min-heap of slot indices holding the upper part of the values.
+  std::vector<uint32_t> high_;
+  float quantile_;
+};
+
+}  // namespace sensor
+}  // namespace esphome
@@ -25,6 +25,10 @@ class SNTPComponent : public time::RealTimeClock {
 
   void update() override;
   void loop() override;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// Reporting the first sync up to a second late is fine, the bounded event wait runs loop() often enough.
+  bool needs_polling() const override { return false; }
+#endif
 
  protected:
   std::vector<std::string> servers_;
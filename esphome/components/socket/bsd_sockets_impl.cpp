@@ -6,6 +6,10 @@
 
 #include <cstring>
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+#include "esphome/core/application.h"
+#endif
+
 #ifdef USE_ESP32
 #include <esp_idf_version.h>
 #include <lwip/sockets.h>
@@ -40,7 +44,11 @@ std::string format_sockaddr(const struct sockaddr_storage &storage) {
 
 class BSDSocketImpl : public Socket {
  public:
-  BSDSocketImpl(int fd) : fd_(fd) {}
+  BSDSocketImpl(int fd) : fd_(fd) {
+#ifdef USE_LOOP_EVENT_DRIVEN
+    App.register_wake_fd(fd);
+#endif
+  }
   ~BSDSocketImpl() override {
     if (!closed_) {
       close();  // NOLINT(clang-analyzer-optin.cplusplus.VirtualCall)
@@ -54,6 +62,9 @@ class BSDSocketImpl : public Socket {
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
   int close() override {
+#ifdef USE_LOOP_EVENT_DRIVEN
+    App.unregister_wake_fd(fd_);
+#endif
     int ret = ::close(fd_);
     closed_ = true;
     return ret;
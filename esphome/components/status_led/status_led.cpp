@@ -28,6 +28,11 @@ void StatusLED::loop() {
     this->pin_->digital_write(false);
   }
 }
+#ifdef USE_LOOP_EVENT_DRIVEN
+bool StatusLED::needs_polling() const {
+  return (App.get_app_state() & (STATUS_LED_ERROR | STATUS_LED_WARNING)) != 0u;
+}
+#endif
 float StatusLED::get_setup_priority() const { return setup_priority::HARDWARE; }
 float StatusLED::get_loop_priority() const { return 50.0f; }
 
@@ -13,6 +13,10 @@ class StatusLED : public Component {
   void pre_setup();
   void dump_config() override;
   void loop() override;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// Only blinking on error or warning needs the regular loop interval.
+  bool needs_polling() const override;
+#endif
   float get_setup_priority() const override;
   float get_loop_priority() const override;
 
@@ -122,6 +122,16 @@ class UARTComponent {
   // @return Baud rate in bits per second.
   uint32_t get_baud_rate() const { return baud_rate_; }
 
+  /**
+   * Make received bytes readable within the given number of symbol times, instead of only once the hardware FIFO
+   * fills up or the line has been idle for the driver's default time.
+   * @param symbols Number of symbol (character) times.
+   * @return False if not supported by the platform.
+   *
+   * Lets protocols that delimit frames by idle time, like Modbus RTU, see the gaps between frames.
+   */
+  virtual bool set_rx_latency(uint8_t symbols) { return false; }
+
 #if defined(USE_ESP8266) || defined(USE_ESP32)
   /**
    * Load the UART settings.
@@ -140,6 +140,8 @@ void IDFUARTComponent::setup() {
   }
 
   xSemaphoreGive(this->lock_);
+
+  this->apply_rx_latency_();
 }
 
 void IDFUARTComponent::load_settings(bool dump_config) {
@@ -153,6 +155,31 @@ void IDFUARTComponent::load_settings(bool dump_config) {
     ESP_LOGCONFIG(TAG, "UART %u was reloaded.", this->uart_num_);
     this->dump_config();
   }
+  this->apply_rx_latency_();
+}
+
+bool IDFUARTComponent::set_rx_latency(uint8_t symbols) {
+  this->rx_latency_ = symbols;
+  // Applied in setup() if the driver isn't installed yet
+  if (this->lock_ == nullptr)
+    return true;
+  return this->apply_rx_latency_();
+}
+
+bool IDFUARTComponent::apply_rx_latency_() {
+  if (this->rx_latency_ == 0)
+    return true;
+  xSemaphoreTake(this->lock_, portMAX_DELAY);
+  // The FIFO full threshold hands over bytes while they keep arriving, the timeout once the line went idle
+  esp_err_t err = uart_set_rx_full_threshold(this->uart_num_, this->rx_latency_);
+  if (err == ESP_OK)
+    err = uart_set_rx_timeout(this->uart_num_, this->rx_latency_);
+  xSemaphoreGive(this->lock_);
+  if (err != ESP_OK) {
+    ESP_LOGW(TAG, "Setting RX latency failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  return true;
 }
 
 void IDFUARTComponent::dump_config() {
@@ -166,6 +193,9 @@ void IDFUARTComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Data Bits: %u", this->data_bits_);
   ESP_LOGCONFIG(TAG, "  Parity: %s", LOG_STR_ARG(parity_to_str(this->parity_)));
   ESP_LOGCONFIG(TAG, "  Stop bits: %u", this->stop_bits_);
+  if (this->rx_latency_ > 0) {
+    ESP_LOGCONFIG(TAG, "  RX Latency: %u symbols", this->rx_latency_);
+  }
   this->check_logger_conflict();
 }
 
@@ -23,6 +23,8 @@ class IDFUARTComponent : public UARTComponent, public Component {
   int available() override;
   void flush() override;
 
+  bool set_rx_latency(uint8_t symbols) override;
+
   uint8_t get_hw_serial_number() { return this->uart_num_; }
   QueueHandle_t *get_uart_event_queue() { return &this->uart_event_queue_; }
 
@@ -43,13 +45,15 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
  protected:
   void check_logger_conflict() override;
+  bool apply_rx_latency_();
   uart_port_t uart_num_;
   QueueHandle_t uart_event_queue_;
   uart_config_t get_config_();
-  SemaphoreHandle_t lock_;
+  SemaphoreHandle_t lock_{nullptr};
 
   bool has_peek_{false};
   uint8_t peek_byte_;
+  uint8_t rx_latency_{0};
 };
 
 }  // namespace uart
@@ -0,0 +1,62 @@
+#include "audio_packet_pool.h"
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace voice_assistant {
+
+bool AudioPacketPool::allocate(uint8_t count, size_t header_size, size_t audio_size, size_t footer_size) {
+  if (this->buffer_ != nullptr)
+    return true;
+  // Keep the audio of every packet aligned for 16 bit samples
+  header_size = (header_size + 1) & ~size_t(1);
+  size_t packet_size = (header_size + audio_size + footer_size + 3) & ~size_t(3);
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  this->buffer_ = allocator.allocate(count * packet_size);
+  if (this->buffer_ == nullptr)
+    return false;
+  this->packet_size_ = packet_size;
+  this->header_size_ = header_size;
+  this->audio_size_ = audio_size;
+  this->count_ = count;
+  this->head_ = 0;
+  this->queued_ = 0;
+  return true;
+}
+
+void AudioPacketPool::deallocate() {
+  if (this->buffer_ == nullptr)
+    return;
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  allocator.deallocate(this->buffer_, this->count_ * this->packet_size_);
+  this->buffer_ = nullptr;
+  this->count_ = 0;
+  this->queued_ = 0;
+}
+
+uint8_t *AudioPacketPool::next() {
+  if (this->buffer_ == nullptr || this->queued_ == this->count_)
+    return nullptr;
+  return this->audio_((this->head_ + this->queued_) % this->count_);
+}
+
+void AudioPacketPool::push() {
+  if (this->queued_ < this->count_)
+    this->queued_++;
+}
+
+uint8_t *AudioPacketPool::front() {
+  if (this->buffer_ == nullptr || this->queued_ == 0)
+    return nullptr;
+  return this->audio_(this->head_);
+}
+
+void AudioPacketPool::pop() {
+  if (this->queued_ == 0)
+    return;
+  this->head_ = (this->head_ + 1) % this->count_;
+  this->queued_--;
+}
+
+}  // namespace voice_assistant
+}  // namespace esphome
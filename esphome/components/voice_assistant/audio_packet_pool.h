@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace voice_assistant {
+
+/** A fixed number of equally sized packets for sending audio, allocated once and used in turn.
+ *
+ * Each packet reserves room in front of and after its audio, so the transport can add its headers in place and send
+ * the audio without copying it. Filled packets are queued in order until they were sent, so a busy connection delays
+ * the audio instead of losing it.
+ */
+class AudioPacketPool {
+ public:
+  /// Allocate count packets, if not already done. Returns false if out of memory.
+  bool allocate(uint8_t count, size_t header_size, size_t audio_size, size_t footer_size);
+  void deallocate();
+  bool is_allocated() const { return this->buffer_ != nullptr; }
+
+  /// Returns the audio of the packet to fill next, or nullptr if all packets are queued.
+  uint8_t *next();
+  /// Queue the packet returned by next().
+  void push();
+  /// Returns the audio of the oldest queued packet, or nullptr if none is queued.
+  uint8_t *front();
+  /// Release the packet returned by front() for filling again.
+  void pop();
+  /// Drop all queued packets.
+  void clear() { this->queued_ = 0; }
+
+  uint8_t queued() const { return this->queued_; }
+  size_t get_audio_size() const { return this->audio_size_; }
+
+ protected:
+  uint8_t *audio_(uint8_t index) { return this->buffer_ + index * this->packet_size_ + this->header_size_; }
+
+  uint8_t *buffer_{nullptr};
+  size_t packet_size_{0};
+  size_t header_size_{0};
+  size_t audio_size_{0};
+  uint8_t count_{0};
+  uint8_t head_{0};
+  uint8_t queued_{0};
+};
+
+}  // namespace voice_assistant
+}  // namespace esphome
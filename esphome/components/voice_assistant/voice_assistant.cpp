@@ -18,13 +18,20 @@ static const char *const TAG = "voice_assistant";
 
 static const size_t SAMPLE_RATE_HZ = 16000;
 static const size_t INPUT_BUFFER_SIZE = 32 * SAMPLE_RATE_HZ / 1000;  // 32ms * 16kHz / 1000ms
-static const size_t BUFFER_SIZE = 512 * SAMPLE_RATE_HZ / 1000;
 static const size_t SEND_BUFFER_SIZE = INPUT_BUFFER_SIZE * sizeof(int16_t);
+static const uint8_t AUDIO_PACKET_COUNT = 4;
 static const size_t RECEIVE_SIZE = 1024;
 static const size_t SPEAKER_BUFFER_SIZE = 16 * RECEIVE_SIZE;
 
 VoiceAssistant::VoiceAssistant() { global_voice_assistant = this; }
 
+void VoiceAssistant::setup() {
+  this->mic_consumer_ = this->mic_->get_audio_ring().add_consumer();
+#ifdef USE_ESP_ADF
+  this->vad_consumer_ = this->mic_->get_audio_ring().add_consumer();
+#endif
+}
+
 float VoiceAssistant::get_setup_priority() const { return setup_priority::AFTER_CONNECTION; }
 
 bool VoiceAssistant::start_udp_socket_() {
@@ -71,7 +78,7 @@ bool VoiceAssistant::start_udp_socket_() {
 }
 
 bool VoiceAssistant::allocate_buffers_() {
-  if (this->send_buffer_ != nullptr) {
+  if (this->audio_packets_.is_allocated()) {
     return true;  // Already allocated
   }
 
@@ -86,6 +93,7 @@ bool VoiceAssistant::allocate_buffers_() {
   }
 #endif
 
+#ifdef USE_ESP_ADF
   ExternalRAMAllocator<int16_t> allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
   this->input_buffer_ = allocator.allocate(INPUT_BUFFER_SIZE);
   if (this->input_buffer_ == nullptr) {
@@ -93,19 +101,12 @@ bool VoiceAssistant::allocate_buffers_() {
     return false;
   }
 
-#ifdef USE_ESP_ADF
   this->vad_instance_ = vad_create(VAD_MODE_4);
 #endif
 
-  this->ring_buffer_ = RingBuffer::create(BUFFER_SIZE * sizeof(int16_t));
-  if (this->ring_buffer_ == nullptr) {
-    ESP_LOGW(TAG, "Could not allocate ring buffer");
-    return false;
-  }
-
-  ExternalRAMAllocator<uint8_t> send_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  this->send_buffer_ = send_allocator.allocate(SEND_BUFFER_SIZE);
-  if (send_buffer_ == nullptr) {
+  // The microphone audio is read straight into packets framed for both the API and UDP
+  if (!this->audio_packets_.allocate(AUDIO_PACKET_COUNT, api::APIConnection::VOICE_ASSISTANT_AUDIO_HEADER_SIZE,
+                                     SEND_BUFFER_SIZE, api::API_MAX_FRAME_FOOTER_SIZE)) {
     ESP_LOGW(TAG, "Could not allocate send buffer");
     return false;
   }
@@ -114,17 +115,15 @@ bool VoiceAssistant::allocate_buffers_() {
 }
 
 void VoiceAssistant::clear_buffers_() {
-  if (this->send_buffer_ != nullptr) {
-    memset(this->send_buffer_, 0, SEND_BUFFER_SIZE);
-  }
+  this->audio_packets_.clear();
 
+#ifdef USE_ESP_ADF
   if (this->input_buffer_ != nullptr) {
     memset(this->input_buffer_, 0, INPUT_BUFFER_SIZE * sizeof(int16_t));
   }
+#endif
 
-  if (this->ring_buffer_ != nullptr) {
-    this->ring_buffer_->reset();
-  }
+  this->mic_->get_audio_ring().discard(this->mic_consumer_);
 
 #ifdef USE_SPEAKER
   if (this->speaker_buffer_ != nullptr) {
@@ -138,25 +137,18 @@ void VoiceAssistant::clear_buffers_() {
 }
 
 void VoiceAssistant::deallocate_buffers_() {
-  ExternalRAMAllocator<uint8_t> send_deallocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  send_deallocator.deallocate(this->send_buffer_, SEND_BUFFER_SIZE);
-  this->send_buffer_ = nullptr;
-
-  if (this->ring_buffer_ != nullptr) {
-    this->ring_buffer_.reset();
-    this->ring_buffer_ = nullptr;
-  }
+  this->audio_packets_.deallocate();
 
 #ifdef USE_ESP_ADF
   if (this->vad_instance_ != nullptr) {
     vad_destroy(this->vad_instance_);
     this->vad_instance_ = nullptr;
   }
-#endif
 
   ExternalRAMAllocator<int16_t> input_deallocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
   input_deallocator.deallocate(this->input_buffer_, INPUT_BUFFER_SIZE);
   this->input_buffer_ = nullptr;
+#endif
 
 #ifdef USE_SPEAKER
   if (this->speaker_buffer_ != nullptr) {
@@ -172,20 +164,64 @@ void VoiceAssistant::reset_conversation_id() {
   ESP_LOGD(TAG, "reset conversation ID");
 }
 
-int VoiceAssistant::read_microphone_() {
-  size_t bytes_read = 0;
-  if (this->mic_->is_running()) {  // Read audio into input buffer
-    bytes_read = this->mic_->read(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-    if (bytes_read == 0) {
-      memset(this->input_buffer_, 0, INPUT_BUFFER_SIZE * sizeof(int16_t));
-      return 0;
+void VoiceAssistant::start_reading_microphone_() {
+  microphone::AudioRing &audio_ring = this->mic_->get_audio_ring();
+  audio_ring.start_reading(this->mic_consumer_);
+#ifdef USE_ESP_ADF
+  audio_ring.start_reading(this->vad_consumer_);
+#endif
+}
+
+void VoiceAssistant::stop_reading_microphone_() {
+  microphone::AudioRing &audio_ring = this->mic_->get_audio_ring();
+  audio_ring.stop_reading(this->mic_consumer_);
+#ifdef USE_ESP_ADF
+  audio_ring.stop_reading(this->vad_consumer_);
+#endif
+}
+
+void VoiceAssistant::send_microphone_audio_() {
+  microphone::AudioRing &audio_ring = this->mic_->get_audio_ring();
+  uint32_t overruns = audio_ring.get_overruns(this->mic_consumer_);
+  if (overruns != this->reported_overruns_) {
+    ESP_LOGW(TAG, "Audio was lost %" PRIu32 " times as it couldn't be sent fast enough",
+             overruns - this->reported_overruns_);
+    this->reported_overruns_ = overruns;
+  }
+
+  // Fill free packets with whole chunks of audio and send them, until the connection can't take more or the
+  // microphone has no more audio
+  do {
+    uint8_t *audio;
+    while (audio_ring.available(this->mic_consumer_) >= INPUT_BUFFER_SIZE &&
+           (audio = this->audio_packets_.next()) != nullptr) {
+      audio_ring.read(this->mic_consumer_, reinterpret_cast<int16_t *>(audio), INPUT_BUFFER_SIZE);
+      this->audio_packets_.push();
+    }
+  } while (this->send_audio_packets_() && audio_ring.available(this->mic_consumer_) >= INPUT_BUFFER_SIZE);
+}
+
+bool VoiceAssistant::send_audio_packets_() {
+  uint8_t *audio;
+  while ((audio = this->audio_packets_.front()) != nullptr) {
+    if (this->audio_mode_ == AUDIO_MODE_API) {
+      // Packets are only released once sent, a busy connection delays the audio instead of dropping it
+      if (!this->api_client_->send_voice_assistant_audio_packet(audio, SEND_BUFFER_SIZE))
+        return false;
+    } else {
+      if (!this->udp_socket_running_) {
+        if (!this->start_udp_socket_()) {
+          this->audio_packets_.clear();
+          this->set_state_(State::STOP_MICROPHONE, State::IDLE);
+          return false;
+        }
+      }
+      this->socket_->sendto(audio, SEND_BUFFER_SIZE, 0, (struct sockaddr *) &this->dest_addr_,
+                            sizeof(this->dest_addr_));
     }
-    // Write audio into ring buffer
-    this->ring_buffer_->write((void *) this->input_buffer_, bytes_read);
-  } else {
-    ESP_LOGD(TAG, "microphone not running");
+    this->audio_packets_.pop();
   }
-  return bytes_read;
+  return true;
 }
 
 void VoiceAssistant::loop() {
@@ -236,20 +272,23 @@ void VoiceAssistant::loop() {
     }
     case State::STARTING_MICROPHONE: {
       if (this->mic_->is_running()) {
+        this->start_reading_microphone_();
         this->set_state_(this->desired_state_);
       }
       break;
     }
 #ifdef USE_ESP_ADF
     case State::WAIT_FOR_VAD: {
-      this->read_microphone_();
+      this->mic_->get_audio_ring().discard(this->vad_consumer_);
       ESP_LOGD(TAG, "Waiting for speech...");
       this->set_state_(State::WAITING_FOR_VAD);
       break;
     }
     case State::WAITING_FOR_VAD: {
-      size_t bytes_read = this->read_microphone_();
-      if (bytes_read > 0) {
+      // The samples stay available to mic_consumer_, so the start of the speech is sent as well
+      microphone::AudioRing &audio_ring = this->mic_->get_audio_ring();
+      while (this->state_ == State::WAITING_FOR_VAD && audio_ring.available(this->vad_consumer_) >= INPUT_BUFFER_SIZE) {
+        audio_ring.read(this->vad_consumer_, this->input_buffer_, INPUT_BUFFER_SIZE);
         vad_state_t vad_state =
             vad_process(this->vad_instance_, this->input_buffer_, SAMPLE_RATE_HZ, VAD_FRAME_LENGTH_MS);
         if (vad_state == VAD_SPEECH) {
@@ -272,7 +311,8 @@ void VoiceAssistant::loop() {
     }
 #endif
     case State::START_PIPELINE: {
-      this->read_microphone_();
+      // Samples lost before the pipeline starts are expected, e.g. while waiting for speech
+      this->reported_overruns_ = this->mic_->get_audio_ring().get_overruns(this->mic_consumer_);
       ESP_LOGD(TAG, "Requesting start...");
       uint32_t flags = 0;
       if (this->use_wake_word_)
@@ -305,34 +345,14 @@ void VoiceAssistant::loop() {
       break;
     }
     case State::STARTING_PIPELINE: {
-      this->read_microphone_();
       break;  // State changed when udp server port received
     }
     case State::STREAMING_MICROPHONE: {
-      this->read_microphone_();
-      size_t available = this->ring_buffer_->available();
-      while (available >= SEND_BUFFER_SIZE) {
-        size_t read_bytes = this->ring_buffer_->read((void *) this->send_buffer_, SEND_BUFFER_SIZE, 0);
-        if (this->audio_mode_ == AUDIO_MODE_API) {
-          api::VoiceAssistantAudio msg;
-          msg.data.assign((char *) this->send_buffer_, read_bytes);
-          this->api_client_->send_voice_assistant_audio(msg);
-        } else {
-          if (!this->udp_socket_running_) {
-            if (!this->start_udp_socket_()) {
-              this->set_state_(State::STOP_MICROPHONE, State::IDLE);
-              break;
-            }
-          }
-          this->socket_->sendto(this->send_buffer_, read_bytes, 0, (struct sockaddr *) &this->dest_addr_,
-                                sizeof(this->dest_addr_));
-        }
-        available = this->ring_buffer_->available();
-      }
-
+      this->send_microphone_audio_();
       break;
     }
     case State::STOP_MICROPHONE: {
+      this->stop_reading_microphone_();
       if (this->mic_->is_running()) {
         this->mic_->stop();
         this->set_state_(State::STOPPING_MICROPHONE);
@@ -726,7 +746,7 @@ void VoiceAssistant::on_event(const api::VoiceAssistantEventResponse &msg) {
     case api::enums::VOICE_ASSISTANT_RUN_END: {
       ESP_LOGD(TAG, "Assist Pipeline ended");
       if (this->state_ == State::STREAMING_MICROPHONE) {
-        this->ring_buffer_->reset();
+        this->mic_->get_audio_ring().discard(this->mic_consumer_);
 #ifdef USE_ESP_ADF
         if (this->use_wake_word_) {
           // No need to stop the microphone since we didn't use the speaker
@@ -809,12 +829,12 @@ void VoiceAssistant::on_event(const api::VoiceAssistantEventResponse &msg) {
 void VoiceAssistant::on_audio(const api::VoiceAssistantAudio &msg) {
 #ifdef USE_SPEAKER  // We should never get to this function if there is no speaker anyway
   if ((this->speaker_ != nullptr) && (this->speaker_buffer_ != nullptr)) {
-    if (this->speaker_buffer_index_ + msg.data.length() < SPEAKER_BUFFER_SIZE) {
-      memcpy(this->speaker_buffer_ + this->speaker_buffer_index_, msg.data.data(), msg.data.length());
-      this->speaker_buffer_index_ += msg.data.length();
-      this->speaker_buffer_size_ += msg.data.length();
-      this->speaker_bytes_received_ += msg.data.length();
-      ESP_LOGV(TAG, "Received audio: %u bytes from API", msg.data.length());
+    if (this->speaker_buffer_index_ + msg.data.size() < SPEAKER_BUFFER_SIZE) {
+      memcpy(this->speaker_buffer_ + this->speaker_buffer_index_, msg.data.c_str(), msg.data.size());
+      this->speaker_buffer_index_ += msg.data.size();
+      this->speaker_buffer_size_ += msg.data.size();
+      this->speaker_bytes_received_ += msg.data.size();
+      ESP_LOGV(TAG, "Received audio: %u bytes from API", msg.data.size());
     } else {
       ESP_LOGE(TAG, "Cannot receive audio, buffer is full");
     }
@@ -7,7 +7,6 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
-#include "esphome/core/ring_buffer.h"
 
 #include "esphome/components/api/api_connection.h"
 #include "esphome/components/api/api_pb2.h"
@@ -20,6 +19,8 @@
 #endif
 #include "esphome/components/socket/socket.h"
 
+#include "audio_packet_pool.h"
+
 #ifdef USE_ESP_ADF
 #include <esp_vad.h>
 #endif
@@ -93,6 +94,7 @@ class VoiceAssistant : public Component {
  public:
   VoiceAssistant();
 
+  void setup() override;
   void loop() override;
   float get_setup_priority() const override;
   void start_streaming();
@@ -205,7 +207,12 @@ class VoiceAssistant : public Component {
   void clear_buffers_();
   void deallocate_buffers_();
 
-  int read_microphone_();
+  void start_reading_microphone_();
+  void stop_reading_microphone_();
+  /// Sends the samples recorded since the last loop to Home Assistant.
+  void send_microphone_audio_();
+  /// Send the queued audio packets in order, returns false if some had to stay queued.
+  bool send_audio_packets_();
   void set_state_(State state);
   void set_state_(State state, State desired_state);
   void signal_stop_();
@@ -274,7 +281,11 @@ class VoiceAssistant : public Component {
   uint8_t vad_threshold_{5};
   uint8_t vad_counter_{0};
 #endif
-  std::unique_ptr<RingBuffer> ring_buffer_;
+  uint8_t mic_consumer_{0};
+#ifdef USE_ESP_ADF
+  uint8_t vad_consumer_{0};
+#endif
+  uint32_t reported_overruns_{0};
 
   bool use_wake_word_;
   uint8_t noise_suppression_level_;
@@ -282,8 +293,10 @@ class VoiceAssistant : public Component {
   float volume_multiplier_;
   uint32_t conversation_timeout_;
 
-  uint8_t *send_buffer_{nullptr};
+  AudioPacketPool audio_packets_;
+#ifdef USE_ESP_ADF
   int16_t *input_buffer_{nullptr};
+#endif
 
   bool continuous_{false};
   bool silence_detection_;
@@ -1,6 +1,7 @@
 #include "web_server.h"
 #ifdef USE_WEBSERVER
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
 #include "esphome/core/entity_base.h"
@@ -209,13 +210,30 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
       (root)["is_disabled_by_default"] = (obj)->is_disabled_by_default(); \
   }
 
-#define set_json_value(root, obj, sensor, value, start_config) \
-  set_json_id((root), (obj), sensor, start_config); \
-  (root)["value"] = value;
+/// Capacity to reserve for an entity's JSON, so it rarely has to grow while it is written.
+static size_t json_size_hint(JsonDetail start_config) { return start_config == DETAIL_ALL ? 256 : 96; }
+
+void WebServer::write_entity_id_(json::JsonWriter &writer, EntityBase *obj, const char *prefix,
+                                 JsonDetail start_config) {
+  writer.add("id", prefix, obj->get_object_id());
+  if (start_config == DETAIL_ALL) {
+    writer.add("name", obj->get_name());
+    writer.add("icon", obj->get_icon());
+    writer.add("entity_category", (int) obj->get_entity_category());
+    if (obj->is_disabled_by_default())
+      writer.add("is_disabled_by_default", true);
+  }
+}
 
-#define set_json_icon_state_value(root, obj, sensor, state, value, start_config) \
-  set_json_value(root, obj, sensor, value, start_config); \
-  (root)["state"] = state;
+void WebServer::write_sorting_(json::JsonWriter &writer, EntityBase *obj) {
+  auto entity = this->sorting_entitys_.find(obj);
+  if (entity == this->sorting_entitys_.end())
+    return;
+  writer.add("sorting_weight", entity->second.weight);
+  auto group = this->sorting_groups_.find(entity->second.group_id);
+  if (group != this->sorting_groups_.end())
+    writer.add("sorting_group", group->second.name);
+}
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
@@ -241,27 +259,27 @@ void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    std::string state;
-    if (std::isnan(value)) {
-      state = "NA";
-    } else {
-      state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-      if (!obj->get_unit_of_measurement().empty())
-        state += " " + obj->get_unit_of_measurement();
-    }
-    set_json_icon_state_value(root, obj, "sensor-" + obj->get_object_id(), state, value, start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-      if (!obj->get_unit_of_measurement().empty())
-        root["uom"] = obj->get_unit_of_measurement();
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "sensor-", start_config);
+  writer.add("value", value);
+  if (std::isnan(value)) {
+    writer.add("state", "NA");
+  } else {
+    std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
+    if (!obj->get_unit_of_measurement().empty())
+      state += " " + obj->get_unit_of_measurement();
+    writer.add("state", state);
+  }
+  if (start_config == DETAIL_ALL) {
+    this->write_sorting_(writer, obj);
+    if (!obj->get_unit_of_measurement().empty())
+      writer.add("uom", obj->get_unit_of_measurement());
+  }
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -290,17 +308,17 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
                                         JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config) + 2 * value.size());
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "text_sensor-", start_config);
+  writer.add("value", value);
+  writer.add("state", value);
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -340,18 +358,19 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
-    if (start_config == DETAIL_ALL) {
-      root["assumed_state"] = obj->assumed_state();
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "switch-", start_config);
+  writer.add("value", value);
+  writer.add("state", value ? "ON" : "OFF");
+  if (start_config == DETAIL_ALL) {
+    writer.add("assumed_state", obj->assumed_state());
+    this->write_sorting_(writer, obj);
+  }
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -380,17 +399,15 @@ void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "button-" + obj->get_object_id(), start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "button-", start_config);
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -418,18 +435,17 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
   request->send(404);
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value,
-                              start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "binary_sensor-", start_config);
+  writer.add("value", value);
+  writer.add("state", value ? "ON" : "OFF");
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -497,25 +513,24 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatc
   request->send(404);
 }
 std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state,
-                              start_config);
-    const auto traits = obj->get_traits();
-    if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
-      root["speed_count"] = traits.supported_speed_count();
-    }
-    if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "fan-", start_config);
+  writer.add("value", obj->state);
+  writer.add("state", obj->state ? "ON" : "OFF");
+  const auto traits = obj->get_traits();
+  if (traits.supports_speed()) {
+    writer.add("speed_level", obj->speed);
+    writer.add("speed_count", traits.supported_speed_count());
+  }
+  if (traits.supports_oscillation())
+    writer.add("oscillation", obj->oscillating);
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -701,24 +716,23 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
-                              obj->position, start_config);
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
-
-    if (obj->get_traits().get_supports_position())
-      root["position"] = obj->position;
-    if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "cover-", start_config);
+  writer.add("value", obj->position);
+  writer.add("state", obj->is_fully_closed() ? "CLOSED" : "OPEN");
+  writer.add("current_operation", cover::cover_operation_to_str(obj->current_operation));
+
+  if (obj->get_traits().get_supports_position())
+    writer.add("position", obj->position);
+  if (obj->get_traits().get_supports_tilt())
+    writer.add("tilt", obj->tilt);
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -763,36 +777,33 @@ void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlM
 }
 
 std::string WebServer::number_json(number::Number *obj, float value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
-    if (start_config == DETAIL_ALL) {
-      root["min_value"] =
-          value_accuracy_to_string(obj->traits.get_min_value(), step_to_accuracy_decimals(obj->traits.get_step()));
-      root["max_value"] =
-          value_accuracy_to_string(obj->traits.get_max_value(), step_to_accuracy_decimals(obj->traits.get_step()));
-      root["step"] =
-          value_accuracy_to_string(obj->traits.get_step(), step_to_accuracy_decimals(obj->traits.get_step()));
-      root["mode"] = (int) obj->traits.get_mode();
-      if (!obj->traits.get_unit_of_measurement().empty())
-        root["uom"] = obj->traits.get_unit_of_measurement();
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-    if (std::isnan(value)) {
-      root["value"] = "\"NaN\"";
-      root["state"] = "NA";
-    } else {
-      root["value"] = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
-      std::string state = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
-      if (!obj->traits.get_unit_of_measurement().empty())
-        state += " " + obj->traits.get_unit_of_measurement();
-      root["state"] = state;
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "number-", start_config);
+  const int8_t accuracy = step_to_accuracy_decimals(obj->traits.get_step());
+  if (start_config == DETAIL_ALL) {
+    writer.add("min_value", value_accuracy_to_string(obj->traits.get_min_value(), accuracy));
+    writer.add("max_value", value_accuracy_to_string(obj->traits.get_max_value(), accuracy));
+    writer.add("step", value_accuracy_to_string(obj->traits.get_step(), accuracy));
+    writer.add("mode", (int) obj->traits.get_mode());
+    if (!obj->traits.get_unit_of_measurement().empty())
+      writer.add("uom", obj->traits.get_unit_of_measurement());
+    this->write_sorting_(writer, obj);
+  }
+  if (std::isnan(value)) {
+    writer.add("value", "\"NaN\"");
+    writer.add("state", "NA");
+  } else {
+    std::string state = value_accuracy_to_string(value, accuracy);
+    writer.add("value", state);
+    if (!obj->traits.get_unit_of_measurement().empty())
+      state += " " + obj->traits.get_unit_of_measurement();
+    writer.add("state", state);
+  }
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -841,20 +852,18 @@ void WebServer::handle_date_request(AsyncWebServerRequest *request, const UrlMat
 }
 
 std::string WebServer::date_json(datetime::DateEntity *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "date-" + obj->get_object_id(), start_config);
-    std::string value = str_sprintf("%d-%02d-%02d", obj->year, obj->month, obj->day);
-    root["value"] = value;
-    root["state"] = value;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "date-", start_config);
+  std::string value = str_sprintf("%d-%02d-%02d", obj->year, obj->month, obj->day);
+  writer.add("value", value);
+  writer.add("state", value);
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif  // USE_DATETIME_DATE
 
@@ -902,20 +911,18 @@ void WebServer::handle_time_request(AsyncWebServerRequest *request, const UrlMat
   request->send(404);
 }
 std::string WebServer::time_json(datetime::TimeEntity *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "time-" + obj->get_object_id(), start_config);
-    std::string value = str_sprintf("%02d:%02d:%02d", obj->hour, obj->minute, obj->second);
-    root["value"] = value;
-    root["state"] = value;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "time-", start_config);
+  std::string value = str_sprintf("%02d:%02d:%02d", obj->hour, obj->minute, obj->second);
+  writer.add("value", value);
+  writer.add("state", value);
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif  // USE_DATETIME_TIME
 
@@ -963,21 +970,19 @@ void WebServer::handle_datetime_request(AsyncWebServerRequest *request, const Ur
   request->send(404);
 }
 std::string WebServer::datetime_json(datetime::DateTimeEntity *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "datetime-" + obj->get_object_id(), start_config);
-    std::string value = str_sprintf("%d-%02d-%02d %02d:%02d:%02d", obj->year, obj->month, obj->day, obj->hour,
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "datetime-", start_config);
+  std::string value = str_sprintf("%d-%02d-%02d %02d:%02d:%02d", obj->year, obj->month, obj->day, obj->hour,
                                     obj->minute, obj->second);
-    root["value"] = value;
-    root["state"] = value;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  writer.add("value", value);
+  writer.add("state", value);
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif  // USE_DATETIME_DATETIME
 
@@ -1021,27 +1026,26 @@ void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMat
 }
 
 std::string WebServer::text_json(text::Text *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_id(root, obj, "text-" + obj->get_object_id(), start_config);
-    root["min_length"] = obj->traits.get_min_length();
-    root["max_length"] = obj->traits.get_max_length();
-    root["pattern"] = obj->traits.get_pattern();
-    if (obj->traits.get_mode() == text::TextMode::TEXT_MODE_PASSWORD) {
-      root["state"] = "********";
-    } else {
-      root["state"] = value;
-    }
-    root["value"] = value;
-    if (start_config == DETAIL_ALL) {
-      root["mode"] = (int) obj->traits.get_mode();
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config) + 2 * value.size());
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "text-", start_config);
+  writer.add("min_length", obj->traits.get_min_length());
+  writer.add("max_length", obj->traits.get_max_length());
+  writer.add("pattern", obj->traits.get_pattern());
+  if (obj->traits.get_mode() == text::TextMode::TEXT_MODE_PASSWORD) {
+    writer.add("state", "********");
+  } else {
+    writer.add("state", value);
+  }
+  writer.add("value", value);
+  if (start_config == DETAIL_ALL) {
+    writer.add("mode", (int) obj->traits.get_mode());
+    this->write_sorting_(writer, obj);
+  }
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -1086,21 +1090,23 @@ void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
-    if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("option");
-      for (auto &option : obj->traits.get_options()) {
-        opt.add(option);
-      }
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "select-", start_config);
+  writer.add("value", value);
+  writer.add("state", value);
+  if (start_config == DETAIL_ALL) {
+    writer.begin_array("option");
+    for (auto &option : obj->traits.get_options()) {
+      writer.add_item(option);
+    }
+    writer.end_array();
+    this->write_sorting_(writer, obj);
+  }
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -1304,18 +1310,17 @@ void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMat
   request->send(404);
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
-                              start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "lock-", start_config);
+  writer.add("value", (int) value);
+  writer.add("state", lock::lock_state_to_string(value));
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -1375,22 +1380,21 @@ void WebServer::handle_valve_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::valve_json(valve::Valve *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "valve-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
-                              obj->position, start_config);
-    root["current_operation"] = valve::valve_operation_to_str(obj->current_operation);
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "valve-", start_config);
+  writer.add("value", obj->position);
+  writer.add("state", obj->is_fully_closed() ? "CLOSED" : "OPEN");
+  writer.add("current_operation", valve::valve_operation_to_str(obj->current_operation));
 
-    if (obj->get_traits().get_supports_position())
-      root["position"] = obj->position;
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  if (obj->get_traits().get_supports_position())
+    writer.add("position", obj->position);
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -1421,19 +1425,18 @@ void WebServer::handle_alarm_control_panel_request(AsyncWebServerRequest *reques
 std::string WebServer::alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
                                                 alarm_control_panel::AlarmControlPanelState value,
                                                 JsonDetail start_config) {
-  return json::build_json([this, obj, value, start_config](JsonObject root) {
-    char buf[16];
-    set_json_icon_state_value(root, obj, "alarm-control-panel-" + obj->get_object_id(),
-                              PSTR_LOCAL(alarm_control_panel_state_to_string(value)), value, start_config);
-    if (start_config == DETAIL_ALL) {
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  char buf[16];
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "alarm-control-panel-", start_config);
+  writer.add("value", (int) value);
+  writer.add("state", PSTR_LOCAL(alarm_control_panel_state_to_string(value)));
+  if (start_config == DETAIL_ALL)
+    this->write_sorting_(writer, obj);
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -1460,25 +1463,25 @@ void WebServer::handle_event_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::event_json(event::Event *obj, const std::string &event_type, JsonDetail start_config) {
-  return json::build_json([this, obj, event_type, start_config](JsonObject root) {
-    set_json_id(root, obj, "event-" + obj->get_object_id(), start_config);
-    if (!event_type.empty()) {
-      root["event_type"] = event_type;
-    }
-    if (start_config == DETAIL_ALL) {
-      JsonArray event_types = root.createNestedArray("event_types");
-      for (auto const &event_type : obj->get_event_types()) {
-        event_types.add(event_type);
-      }
-      root["device_class"] = obj->get_device_class();
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "event-", start_config);
+  if (!event_type.empty()) {
+    writer.add("event_type", event_type);
+  }
+  if (start_config == DETAIL_ALL) {
+    writer.begin_array("event_types");
+    for (auto const &event_type : obj->get_event_types()) {
+      writer.add_item(event_type);
+    }
+    writer.end_array();
+    writer.add("device_class", obj->get_device_class());
+    this->write_sorting_(writer, obj);
+  }
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -1516,36 +1519,35 @@ void WebServer::handle_update_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::update_json(update::UpdateEntity *obj, JsonDetail start_config) {
-  return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "update-" + obj->get_object_id(), start_config);
-    root["value"] = obj->update_info.latest_version;
-    switch (obj->state) {
-      case update::UPDATE_STATE_NO_UPDATE:
-        root["state"] = "NO UPDATE";
-        break;
-      case update::UPDATE_STATE_AVAILABLE:
-        root["state"] = "UPDATE AVAILABLE";
-        break;
-      case update::UPDATE_STATE_INSTALLING:
-        root["state"] = "INSTALLING";
-        break;
-      default:
-        root["state"] = "UNKNOWN";
-        break;
-    }
-    if (start_config == DETAIL_ALL) {
-      root["current_version"] = obj->update_info.current_version;
-      root["title"] = obj->update_info.title;
-      root["summary"] = obj->update_info.summary;
-      root["release_url"] = obj->update_info.release_url;
-      if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
-        root["sorting_weight"] = this->sorting_entitys_[obj].weight;
-        if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
-          root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
-        }
-      }
-    }
-  });
+  std::string output;
+  output.reserve(json_size_hint(start_config));
+  json::JsonWriter writer(output);
+  writer.begin_object();
+  this->write_entity_id_(writer, obj, "update-", start_config);
+  writer.add("value", obj->update_info.latest_version);
+  switch (obj->state) {
+    case update::UPDATE_STATE_NO_UPDATE:
+      writer.add("state", "NO UPDATE");
+      break;
+    case update::UPDATE_STATE_AVAILABLE:
+      writer.add("state", "UPDATE AVAILABLE");
+      break;
+    case update::UPDATE_STATE_INSTALLING:
+      writer.add("state", "INSTALLING");
+      break;
+    default:
+      writer.add("state", "UNKNOWN");
+      break;
+  }
+  if (start_config == DETAIL_ALL) {
+    writer.add("current_version", obj->update_info.current_version);
+    writer.add("title", obj->update_info.title);
+    writer.add("summary", obj->update_info.summary);
+    writer.add("release_url", obj->update_info.release_url);
+    this->write_sorting_(writer, obj);
+  }
+  writer.end_object();
+  return output;
 }
 #endif
 
@@ -4,6 +4,7 @@
 
 #include "esphome/components/web_server_base/web_server_base.h"
 #ifdef USE_WEBSERVER
+#include "esphome/components/json/json_writer.h"
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/entity_base.h"
@@ -351,6 +352,10 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 
  protected:
   void schedule_(std::function<void()> &&f);
+  /// Write the id of obj, and with DETAIL_ALL the fields every entity has.
+  void write_entity_id_(json::JsonWriter &writer, EntityBase *obj, const char *prefix, JsonDetail start_config);
+  /// Write the sorting weight and group of obj, if it has any.
+  void write_sorting_(json::JsonWriter &writer, EntityBase *obj);
   friend ListEntitiesIterator;
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
@@ -208,6 +208,20 @@ void WiFiComponent::loop() {
   }
 }
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+bool WiFiComponent::needs_polling() const {
+  switch (this->state_) {
+    case WIFI_COMPONENT_STATE_STA_CONNECTED:
+    case WIFI_COMPONENT_STATE_OFF:
+    case WIFI_COMPONENT_STATE_AP:
+    case WIFI_COMPONENT_STATE_DISABLED:
+      return false;
+    default:
+      return true;
+  }
+}
+#endif
+
 WiFiComponent::WiFiComponent() { global_wifi_component = this; }
 
 bool WiFiComponent::has_ap() const { return this->has_ap_; }
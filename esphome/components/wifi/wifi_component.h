@@ -262,6 +262,10 @@ class WiFiComponent : public Component {
 
   /// Reconnect WiFi if required.
   void loop() override;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// Scanning and connecting are polled, connection changes afterwards are reported by the WiFi events.
+  bool needs_polling() const override;
+#endif
 
   bool has_sta() const;
   bool has_ap() const;
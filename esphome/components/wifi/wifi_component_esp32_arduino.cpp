@@ -494,6 +494,10 @@ using esphome_wifi_event_id_t = arduino_event_id_t;
 using esphome_wifi_event_info_t = arduino_event_info_t;
 
 void WiFiComponent::wifi_event_callback_(esphome_wifi_event_id_t event, esphome_wifi_event_info_t info) {
+#ifdef USE_LOOP_EVENT_DRIVEN
+  // Runs on the Arduino event task, let loop() handle the connection change
+  App.wake_loop();
+#endif
   switch (event) {
     case ESPHOME_EVENT_ID_WIFI_READY: {
       ESP_LOGV(TAG, "Event: WiFi ready");
@@ -7,10 +7,27 @@
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+#include <algorithm>
+#include <sys/select.h>
+#include <unistd.h>
+#ifdef USE_ESP32
+#include <esp_vfs_eventfd.h>
+#endif
+#ifdef USE_HOST
+#include <fcntl.h>
+#endif
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+// Upper bound for a single wait, so the task watchdog keeps being fed while idle.
+static const uint32_t MAX_EVENT_WAIT_MS = 1000;
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -27,6 +44,9 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+#ifdef USE_LOOP_EVENT_DRIVEN
+  this->setup_wake_fd_();
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -65,14 +85,23 @@ void Application::setup() {
 }
 void Application::loop() {
   uint32_t new_app_state = 0;
+#ifdef USE_LOOP_EVENT_DRIVEN
+  bool polling_required = false;
+#endif
 
   this->scheduler.call();
   this->feed_wdt();
   for (Component *component : this->looping_components_) {
     {
       WarnIfComponentBlockingGuard guard{component};
+#ifdef USE_LOOP_PROFILER
+      TimingHistogramGuard timing{&component->get_loop_histogram()};
+#endif
       component->call();
     }
+#ifdef USE_LOOP_EVENT_DRIVEN
+    polling_required |= component->needs_polling();
+#endif
     new_app_state |= component->get_component_state();
     this->app_state_ |= new_app_state;
     this->feed_wdt();
@@ -81,6 +110,16 @@ void Application::loop() {
 
   const uint32_t now = millis();
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+  if (!polling_required && this->wake_read_fd_ != -1 && this->dump_config_at_ >= this->components_.size() &&
+      !HighFrequencyLoopRequester::is_high_frequency()) {
+    uint32_t timeout = this->scheduler.next_schedule_in().value_or(MAX_EVENT_WAIT_MS);
+    this->wait_for_events_(std::min(timeout, MAX_EVENT_WAIT_MS));
+    this->last_loop_ = now;
+    return;
+  }
+#endif
+
   auto elapsed = now - this->last_loop_;
   if (elapsed >= this->loop_interval_ || HighFrequencyLoopRequester::is_high_frequency()) {
     yield();
@@ -150,6 +189,114 @@ void Application::calculate_looping_components_() {
   }
 }
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+void Application::setup_wake_fd_() {
+#ifdef USE_ESP32
+  esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+  esp_err_t err = esp_vfs_eventfd_register(&config);
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+    ESP_LOGW(TAG, "Registering eventfd failed: %s, falling back to polling", esp_err_to_name(err));
+    return;
+  }
+  // Readable by select() together with the lwIP sockets, and writable from interrupt handlers
+  int fd = eventfd(0, EFD_SUPPORT_ISR);
+  if (fd == -1) {
+    ESP_LOGW(TAG, "Creating eventfd failed, falling back to polling");
+    return;
+  }
+  this->wake_read_fd_ = fd;
+  this->wake_write_fd_ = fd;
+  // Writing the eventfd goes through the VFS, which lives in flash. Interrupt handlers notify this task instead.
+  xTaskCreate(
+      [](void *arg) {
+        auto *app = static_cast<Application *>(arg);
+        while (true) {
+          ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+          app->wake_loop();
+        }
+      },
+      "loop_wake", 2048, this, uxTaskPriorityGet(nullptr) + 1, &this->isr_wake_task_);
+#endif
+#ifdef USE_HOST
+  int fds[2];
+  if (::pipe(fds) != 0) {
+    ESP_LOGW(TAG, "Creating wake pipe failed, falling back to polling");
+    return;
+  }
+  ::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+  ::fcntl(fds[1], F_SETFL, O_NONBLOCK);
+  this->wake_read_fd_ = fds[0];
+  this->wake_write_fd_ = fds[1];
+#endif
+}
+
+void Application::wait_for_events_(uint32_t timeout) {
+  fd_set read_fds;
+  FD_ZERO(&read_fds);
+  FD_SET(this->wake_read_fd_, &read_fds);
+  int max_fd = this->wake_read_fd_;
+  for (int fd : this->wake_fds_) {
+    FD_SET(fd, &read_fds);
+    max_fd = std::max(max_fd, fd);
+  }
+  struct timeval tv;
+  tv.tv_sec = timeout / 1000;
+  tv.tv_usec = (timeout % 1000) * 1000;
+  int ret = ::select(max_fd + 1, &read_fds, nullptr, nullptr, &tv);
+  // Clear the flag before draining, a wake-up racing with the drain then writes again and is not lost
+  this->wake_pending_ = false;
+  if (ret > 0 && FD_ISSET(this->wake_read_fd_, &read_fds)) {
+#ifdef USE_ESP32
+    // Reading resets the counter. It can't fail after select() reported the fd readable, and if it did the next
+    // select() would just return right away again.
+    uint64_t count;
+    (void) ::read(this->wake_read_fd_, &count, sizeof(count));
+#else
+    uint8_t buf[16];
+    while (::read(this->wake_read_fd_, buf, sizeof(buf)) > 0) {
+    }
+#endif
+  }
+}
+
+void Application::wake_loop() {
+  // One write per loop iteration is enough, the flag is cleared once the loop has been woken up
+  if (this->wake_write_fd_ == -1 || this->wake_pending_.exchange(true))
+    return;
+#ifdef USE_ESP32
+  uint64_t count = 1;
+  const ssize_t expected = sizeof(count);
+  const ssize_t written = ::write(this->wake_write_fd_, &count, sizeof(count));
+#else
+  // A full pipe fails with EAGAIN, but then the loop is woken up by the bytes already in it
+  uint8_t byte = 1;
+  const ssize_t expected = 1;
+  const ssize_t written = ::write(this->wake_write_fd_, &byte, 1);
+#endif
+  if (written != expected) {
+    // Let the next call try again instead of assuming a wake-up is on its way
+    this->wake_pending_ = false;
+  }
+}
+
+void IRAM_ATTR Application::wake_loop_isrsafe() {
+#ifdef USE_ESP32
+  if (this->isr_wake_task_ == nullptr || this->wake_pending_.load())
+    return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(this->isr_wake_task_, &woken);
+  portYIELD_FROM_ISR(woken);
+#else
+  this->wake_loop();
+#endif
+}
+
+void Application::register_wake_fd(int fd) { this->wake_fds_.push_back(fd); }
+void Application::unregister_wake_fd(int fd) {
+  this->wake_fds_.erase(std::remove(this->wake_fds_.begin(), this->wake_fds_.end(), fd), this->wake_fds_.end());
+}
+#endif  // USE_LOOP_EVENT_DRIVEN
+
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 }  // namespace esphome
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
+
+#if defined(USE_LOOP_EVENT_DRIVEN) && defined(USE_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/hal.h"
@@ -231,8 +237,24 @@ class Application {
 
   uint32_t get_loop_interval() const { return this->loop_interval_; }
 
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// Wake up the main loop if it is waiting for events, safe to call from any task.
+  void wake_loop();
+
+  /// Wake up the main loop if it is waiting for events, from an interrupt handler. Lives in IRAM, so it may be called
+  /// while the flash cache is disabled.
+  void wake_loop_isrsafe();
+
+  /// Wake up the main loop whenever the given socket file descriptor becomes readable.
+  void register_wake_fd(int fd);
+
+  void unregister_wake_fd(int fd);
+#endif
+
   void feed_wdt();
 
   void reboot();
@@ -470,6 +492,14 @@ class Application {
 
   void feed_wdt_arch_();
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+  /// Create the eventfd (ESP32) or pipe (host) that wake_loop() writes to.
+  void setup_wake_fd_();
+
+  /// Block until the timeout expires or a wake-up event arrives.
+  void wait_for_events_(uint32_t timeout);
+#endif
+
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
 
@@ -547,6 +577,16 @@ class Application {
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+#ifdef USE_LOOP_EVENT_DRIVEN
+  std::atomic<bool> wake_pending_{false};
+  std::vector<int> wake_fds_{};
+  int wake_read_fd_{-1};
+  int wake_write_fd_{-1};
+#ifdef USE_ESP32
+  /// Writes the eventfd on behalf of interrupt handlers, which can only notify a task from IRAM.
+  TaskHandle_t isr_wake_task_{nullptr};
+#endif
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
@@ -43,6 +43,8 @@ uint32_t global_state = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-v
 
 float Component::get_loop_priority() const { return 0.0f; }
 
+bool Component::needs_polling() const { return true; }
+
 float Component::get_setup_priority() const { return setup_priority::DATA; }
 
 void Component::setup() {}
@@ -5,8 +5,13 @@
 #include <functional>
 #include <string>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
 
+#ifdef USE_LOOP_PROFILER
+#include "esphome/core/profiler.h"
+#endif
+
 namespace esphome {
 
 /** Default setup priorities for components of different types.
@@ -103,6 +108,17 @@ class Component {
    */
   virtual float get_loop_priority() const;
 
+  /** Whether loop() has to be called at the regular loop interval.
+   *
+   * With the event-driven loop mode the main loop sleeps until the next scheduler deadline, a socket becoming
+   * readable or an App.wake_loop() call, but only if none of the looping components needs polling. This is checked
+   * after every loop() call, so components whose loop() only reacts to such events can return false while idle and
+   * true while they have work in flight.
+   *
+   * Defaults to true.
+   */
+  virtual bool needs_polling() const;
+
   void call();
 
   virtual void on_shutdown() {}
@@ -153,6 +169,13 @@ class Component {
    */
   const char *get_component_source() const;
 
+#ifdef USE_LOOP_PROFILER
+  /// Execution times of this component's loop() calls.
+  TimingHistogram &get_loop_histogram() { return this->loop_histogram_; }
+  /// Execution times of the timeouts/intervals this component scheduled.
+  TimingHistogram &get_scheduler_histogram() { return this->scheduler_histogram_; }
+#endif
+
  protected:
   friend class Application;
 
@@ -272,6 +295,10 @@ class Component {
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+#ifdef USE_LOOP_PROFILER
+  TimingHistogram loop_histogram_;
+  TimingHistogram scheduler_histogram_;
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
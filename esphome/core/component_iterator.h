@@ -19,6 +19,8 @@ class UserServiceDescriptor;
 class ComponentIterator {
  public:
   void begin(bool include_internal = false);
+  /// Whether begin() was called and the iteration has not finished yet.
+  bool is_active() const { return this->state_ != IteratorState::NONE; }
   void advance();
   virtual bool on_begin();
 #ifdef USE_BINARY_SENSOR
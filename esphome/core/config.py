@@ -96,6 +96,15 @@ def valid_include(value):
     return value
 
 
+def validate_loop_mode(value):
+    value = cv.one_of(LOOP_MODE_POLLING, LOOP_MODE_EVENT_DRIVEN, lower=True)(value)
+    if value == LOOP_MODE_EVENT_DRIVEN and not (CORE.is_esp32 or CORE.is_host):
+        raise cv.Invalid(
+            f"The {LOOP_MODE_EVENT_DRIVEN} loop mode is only available on ESP32 and host"
+        )
+    return value
+
+
 def valid_project_name(value: str):
     if value.count(".") != 1:
         raise cv.Invalid("project name needs to have a namespace")
@@ -112,6 +121,17 @@ else:
 
 
 CONF_ESP8266_RESTORE_FROM_FLASH = "esp8266_restore_from_flash"
+CONF_SCHEDULER = "scheduler"
+CONF_POOL_SIZE = "pool_size"
+
+CONF_LOOP_MODE = "loop_mode"
+
+LOOP_MODE_POLLING = "polling"
+LOOP_MODE_EVENT_DRIVEN = "event_driven"
+
+SCHEDULER_TYPE_HEAP = "heap"
+SCHEDULER_TYPE_TIMER_WHEEL = "timer_wheel"
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -166,6 +186,17 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_COMPILE_PROCESS_LIMIT, default=_compile_process_limit_default
             ): cv.int_range(min=1, max=multiprocessing.cpu_count()),
+            cv.Optional(CONF_LOOP_MODE, default=LOOP_MODE_POLLING): validate_loop_mode,
+            cv.Optional(CONF_SCHEDULER, default={}): cv.Schema(
+                {
+                    cv.Optional(CONF_TYPE, default=SCHEDULER_TYPE_HEAP): cv.one_of(
+                        SCHEDULER_TYPE_HEAP, SCHEDULER_TYPE_TIMER_WHEEL, lower=True
+                    ),
+                    cv.Optional(CONF_POOL_SIZE, default=64): cv.int_range(
+                        min=8, max=1024
+                    ),
+                }
+            ),
         }
     ),
     validate_hostname,
@@ -403,5 +434,13 @@ async def to_code(config):
                 trigger, [(cg.std_string, "version")], conf
             )
 
+    if config[CONF_LOOP_MODE] == LOOP_MODE_EVENT_DRIVEN:
+        cg.add_define("USE_LOOP_EVENT_DRIVEN")
+
+    scheduler_conf = config[CONF_SCHEDULER]
+    if scheduler_conf[CONF_TYPE] == SCHEDULER_TYPE_TIMER_WHEEL:
+        cg.add_define("USE_SCHEDULER_TIMER_WHEEL")
+        cg.add_define("ESPHOME_SCHEDULER_POOL_SIZE", scheduler_conf[CONF_POOL_SIZE])
+
     if config[CONF_PLATFORMIO_OPTIONS]:
         CORE.add_job(_add_platformio_options, config[CONF_PLATFORMIO_OPTIONS])
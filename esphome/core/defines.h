@@ -40,6 +40,7 @@
 #define USE_LIGHT
 #define USE_LOCK
 #define USE_LOGGER
+#define USE_LOOP_PROFILER
 #define USE_LVGL
 #define USE_LVGL_ANIMIMG
 #define USE_LVGL_BINARY_SENSOR
@@ -102,6 +103,7 @@
 #define USE_ESP32_BLE_SERVER
 #define USE_ESP32_CAMERA
 #define USE_IMPROV
+#define USE_LOGGER_BINARY
 #define USE_MICRO_WAKE_WORD_VAD
 #define USE_MICROPHONE
 #define USE_PSRAM
@@ -0,0 +1,42 @@
+#include "profiler.h"
+
+#ifdef USE_LOOP_PROFILER
+
+#include <cstring>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+void HOT TimingHistogram::record(uint32_t duration_us) {
+  uint8_t bucket = 0;
+  if (duration_us >= 8) {
+    bucket = 31 - __builtin_clz(duration_us) - 2;
+    if (bucket >= BUCKETS)
+      bucket = BUCKETS - 1;
+  }
+  this->counts_[bucket]++;
+  this->total_us_ += duration_us;
+  if (duration_us > this->max_us_)
+    this->max_us_ = duration_us;
+}
+void TimingHistogram::reset() {
+  memset(this->counts_, 0, sizeof(this->counts_));
+  this->total_us_ = 0;
+  this->max_us_ = 0;
+}
+uint32_t TimingHistogram::get_total_count() const {
+  uint32_t total = 0;
+  for (uint32_t count : this->counts_)
+    total += count;
+  return total;
+}
+uint32_t TimingHistogram::get_bucket_upper_bound_us(uint8_t bucket) {
+  if (bucket >= BUCKETS - 1)
+    return UINT32_MAX;
+  return 1UL << (bucket + 3);
+}
+
+}  // namespace esphome
+
+#endif  // USE_LOOP_PROFILER
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
+
+#ifdef USE_LOOP_PROFILER
+
+namespace esphome {
+
+/** Fixed-size histogram of execution times with logarithmically sized buckets.
+ *
+ * Bucket 0 counts durations below 8 µs, bucket N (N > 0) counts durations in [2^(N+2), 2^(N+3)) µs and the
+ * last bucket counts everything from 2^17 µs (~131 ms) upwards.
+ */
+class TimingHistogram {
+ public:
+  static const uint8_t BUCKETS = 16;
+
+  void record(uint32_t duration_us);
+  void reset();
+
+  uint32_t get_count(uint8_t bucket) const { return this->counts_[bucket]; }
+  uint32_t get_total_count() const;
+  uint64_t get_total_us() const { return this->total_us_; }
+  uint32_t get_max_us() const { return this->max_us_; }
+
+  /// Exclusive upper bound of the given bucket in µs, UINT32_MAX for the last bucket.
+  static uint32_t get_bucket_upper_bound_us(uint8_t bucket);
+
+ protected:
+  uint32_t counts_[BUCKETS]{};
+  uint64_t total_us_{0};
+  uint32_t max_us_{0};
+};
+
+/// Records the time between construction and destruction into a histogram, nullptr disables recording.
+class TimingHistogramGuard {
+ public:
+  explicit TimingHistogramGuard(TimingHistogram *histogram) : histogram_(histogram), started_(micros()) {}
+  ~TimingHistogramGuard() {
+    if (this->histogram_ != nullptr)
+      this->histogram_->record(micros() - this->started_);
+  }
+
+ protected:
+  TimingHistogram *histogram_;
+  uint32_t started_;
+};
+
+}  // namespace esphome
+
+#endif  // USE_LOOP_PROFILER
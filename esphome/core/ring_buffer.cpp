@@ -90,6 +90,10 @@ size_t RingBuffer::write_without_replacement(const void *data, size_t len, TickT
   return len;
 }
 
+bool RingBuffer::write_atomic(const void *data, size_t len, TickType_t ticks_to_wait) {
+  return xRingbufferSend(this->handle_, data, len, ticks_to_wait) == pdTRUE;
+}
+
 size_t RingBuffer::available() const {
   UBaseType_t ux_items_waiting = 0;
   vRingbufferGetInfo(this->handle_, nullptr, nullptr, nullptr, nullptr, &ux_items_waiting);
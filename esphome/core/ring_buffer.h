@@ -52,6 +52,20 @@ class RingBuffer {
    */
   size_t write_without_replacement(const void *data, size_t len, TickType_t ticks_to_wait = 0);
 
+  /**
+   * @brief Writes all of the data to the ring buffer or nothing at all.
+   *
+   * Unlike write_without_replacement(), a partial write never happens, so several tasks can each write
+   * self-contained records without interleaving their bytes. If not enough space is available,
+   * the function will wait up to `ticks_to_wait` FreeRTOS ticks before giving up.
+   *
+   * @param data Pointer to data for writing
+   * @param len Number of bytes to write
+   * @param ticks_to_wait Maximum number of FreeRTOS ticks to wait (default: 0)
+   * @return True if all bytes were written, false if nothing was written
+   */
+  bool write_atomic(const void *data, size_t len, TickType_t ticks_to_wait = 0);
+
   /**
    * @brief Returns the number of available bytes in the ring buffer.
    *
@@ -5,15 +5,20 @@
 #include <algorithm>
 #include <cinttypes>
 
+#ifdef USE_LOOP_EVENT_DRIVEN
+#include "esphome/core/application.h"
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "scheduler";
 
-static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
-
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
 
+#ifndef USE_SCHEDULER_TIMER_WHEEL
+static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+
 // A note on locking: the `lock_` lock protects the `items_` and `to_add_` containers. It must be taken when writing to
 // them (i.e. when adding/removing items, but not when changing items). As items are only deleted from the loop task,
 // iterating over them from the loop task is fine; but iterating from any other context requires the lock to be held to
@@ -79,6 +84,79 @@ bool HOT Scheduler::cancel_interval(Component *component, const std::string &nam
   return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
 }
 
+#else  // USE_SCHEDULER_TIMER_WHEEL
+
+// A note on locking: the `lock_` lock protects the wheel slots, the expired and immediate lists, the name index and the
+// item pool. It must be taken whenever an item is linked into or out of any of them. Callbacks are run without the lock
+// held, an item that is currently running is never part of the wheel and is only flagged with `remove` when it gets
+// cancelled.
+
+Scheduler::Scheduler() {
+  for (auto &item : this->pool_) {
+    item.state = SchedulerItem::FREE;
+    item.pooled = true;
+    item.next = this->free_;
+    this->free_ = &item;
+  }
+}
+
+void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
+                                std::function<void()> func) {
+  const uint32_t now = this->millis_();
+
+  if (!name.empty())
+    this->cancel_timeout(component, name);
+
+  if (timeout == SCHEDULER_DONT_RUN)
+    return;
+
+  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name.c_str(), timeout);
+
+  LockGuard guard{this->lock_};
+  auto *item = this->acquire_();
+  item->component = component;
+  item->type = SchedulerItem::TIMEOUT;
+  item->interval = timeout;
+  item->next_execution = this->millis_64_(now) + timeout;
+  item->callback = std::move(func);
+  this->push_(item, name);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+}
+void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
+                                 std::function<void()> func) {
+  const uint32_t now = this->millis_();
+
+  if (!name.empty())
+    this->cancel_interval(component, name);
+
+  if (interval == SCHEDULER_DONT_RUN)
+    return;
+
+  // only put offset in lower half
+  uint32_t offset = 0;
+  if (interval != 0)
+    offset = (random_uint32() % interval) / 2;
+
+  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name.c_str(), interval, offset);
+
+  const uint64_t now_64 = this->millis_64_(now);
+  LockGuard guard{this->lock_};
+  auto *item = this->acquire_();
+  item->component = component;
+  item->type = SchedulerItem::INTERVAL;
+  item->interval = interval;
+  // First execution happens right away, the offset only shifts the phase of the following ones
+  item->next_execution = now_64 > offset ? now_64 - offset : 0;
+  item->callback = std::move(func);
+  this->push_(item, name);
+}
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+}
+#endif  // USE_SCHEDULER_TIMER_WHEEL
+
 struct RetryArgs {
   std::function<RetryResult(uint8_t)> func;
   uint8_t retry_countdown;
@@ -134,6 +212,7 @@ bool HOT Scheduler::cancel_retry(Component *component, const std::string &name)
   return this->cancel_timeout(component, "retry$" + name);
 }
 
+#ifndef USE_SCHEDULER_TIMER_WHEEL
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
   if (this->empty_())
     return {};
@@ -231,6 +310,10 @@ void HOT Scheduler::call() {
       //  - timeouts/intervals get cancelled
       {
         WarnIfComponentBlockingGuard guard{item->component};
+#ifdef USE_LOOP_PROFILER
+        TimingHistogramGuard timing{item->component == nullptr ? nullptr
+                                                               : &item->component->get_scheduler_histogram()};
+#endif
         item->callback();
       }
     }
@@ -299,8 +382,14 @@ void HOT Scheduler::pop_raw_() {
   this->items_.pop_back();
 }
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
-  LockGuard guard{this->lock_};
-  this->to_add_.push_back(std::move(item));
+  {
+    LockGuard guard{this->lock_};
+    this->to_add_.push_back(std::move(item));
+  }
+#ifdef USE_LOOP_EVENT_DRIVEN
+  // The new item might be due before the main loop would wake up on its own
+  App.wake_loop();
+#endif
 }
 bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
   // obtain lock because this function iterates and can be called from non-loop task context
@@ -322,16 +411,6 @@ bool HOT Scheduler::cancel_item_(Component *component, const std::string &name,
 
   return ret;
 }
-uint32_t Scheduler::millis_() {
-  const uint32_t now = millis();
-  if (now < this->last_millis_) {
-    ESP_LOGD(TAG, "Incrementing scheduler major");
-    this->millis_major_++;
-  }
-  this->last_millis_ = now;
-  return now;
-}
-
 bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
                                        const std::unique_ptr<SchedulerItem> &b) {
   // min-heap
@@ -361,4 +440,336 @@ bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
   return a_next_exec > b_next_exec;
 }
 
+#else  // USE_SCHEDULER_TIMER_WHEEL
+
+// Index of the first set bit of `bitmap` when walking the slots in order starting at `start`.
+static inline uint8_t first_slot(uint32_t bitmap, uint8_t start) {
+  uint32_t rotated = start == 0 ? bitmap : (bitmap >> start) | (bitmap << (32 - start));
+  return (start + __builtin_ctz(rotated)) & 31;
+}
+
+optional<uint32_t> HOT Scheduler::next_schedule_in() {
+  const uint64_t now = this->millis_64_(this->millis_());
+  LockGuard guard{this->lock_};
+  if (this->expired_head_ != nullptr || this->immediate_head_ != nullptr)
+    return 0;
+  if (this->wheel_empty_())
+    return {};
+
+  uint64_t next_time = UINT64_MAX;
+  for (uint8_t level = 0; level < WHEEL_LEVELS; level++) {
+    if (this->occupied_[level] == 0)
+      continue;
+    uint8_t current = (this->current_tick_ >> (level * WHEEL_BITS)) & WHEEL_MASK;
+    if (level == 0) {
+      // Slots of the finest level hold exactly one deadline each
+      uint8_t slot = first_slot(this->occupied_[0], current);
+      next_time = this->current_tick_ + ((slot - current) & WHEEL_MASK);
+      continue;
+    }
+    // The current slot of a coarser level is cascaded when the tick with all finer bits zero is processed. Until then
+    // it holds the earliest items of the level, afterwards only items of the next rotation.
+    const uint64_t finer_mask = (1ULL << (level * WHEEL_BITS)) - 1;
+    const bool current_pending = (this->current_tick_ & finer_mask) == 0;
+    uint8_t slot = first_slot(this->occupied_[level], current_pending ? current : (current + 1) & WHEEL_MASK);
+    for (auto *item = this->slots_[level][slot]; item != nullptr; item = item->next)
+      next_time = std::min(next_time, std::max(item->next_execution, this->current_tick_));
+  }
+
+  if (next_time <= now)
+    return 0;
+  return std::min<uint64_t>(next_time - now, UINT32_MAX);
+}
+void HOT Scheduler::call() {
+  const uint32_t now = this->millis_();
+  const uint64_t now_64 = this->millis_64_(now);
+
+  {
+    LockGuard guard{this->lock_};
+    // Items added as already due since the last call run first, then everything the wheel expires up to now
+    if (this->immediate_head_ != nullptr) {
+      this->immediate_tail_->next = this->expired_head_;
+      if (this->expired_head_ == nullptr)
+        this->expired_tail_ = this->immediate_tail_;
+      this->expired_head_ = this->immediate_head_;
+      this->immediate_head_ = nullptr;
+      this->immediate_tail_ = nullptr;
+    }
+    this->advance_(now_64);
+  }
+
+  while (true) {
+    SchedulerItem *item;
+    {
+      LockGuard guard{this->lock_};
+      item = this->expired_head_;
+      if (item == nullptr)
+        break;
+      this->expired_head_ = item->next;
+      if (this->expired_head_ == nullptr)
+        this->expired_tail_ = nullptr;
+
+      if (item->remove) {
+        // Cancelled while waiting in the expired list
+        this->release_(item);
+        continue;
+      }
+      // Don't run on failed components
+      if (item->component != nullptr && item->component->is_failed()) {
+        this->unindex_(item);
+        this->release_(item);
+        continue;
+      }
+    }
+
+#ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+    ESP_LOGVV(TAG, "Running %s 0x%08" PRIX32 " with interval=%" PRIu32 " (now=%" PRIu32 ")", item->get_type_str(),
+              item->name_hash, item->interval, now);
+#endif
+
+    // The item is not part of any container while running, so the callback is free to add and cancel items.
+    // Cancelling the running item itself only flags it for removal.
+    {
+      WarnIfComponentBlockingGuard guard{item->component};
+#ifdef USE_LOOP_PROFILER
+      TimingHistogramGuard timing{item->component == nullptr ? nullptr : &item->component->get_scheduler_histogram()};
+#endif
+      item->callback();
+    }
+
+    LockGuard guard{this->lock_};
+    if (item->remove) {
+      this->release_(item);
+    } else if (item->type == SchedulerItem::TIMEOUT) {
+      this->unindex_(item);
+      this->release_(item);
+    } else {
+      if (item->interval != 0) {
+        const uint64_t amount = (now_64 - std::min(now_64, item->next_execution)) / item->interval + 1;
+        item->next_execution += amount * item->interval;
+      } else {
+        item->next_execution = now_64;
+      }
+      this->insert_(item);
+    }
+  }
+}
+void HOT Scheduler::process_to_add() {
+  // Items are linked into the wheel directly when they are added, nothing to do.
+}
+Scheduler::SchedulerItem *HOT Scheduler::acquire_() {
+  SchedulerItem *item = this->free_;
+  if (item != nullptr) {
+    this->free_ = item->next;
+  } else {
+    if (!this->pool_exhausted_logged_) {
+      ESP_LOGW(TAG, "Scheduler pool of %u items exhausted, allocating from heap. Consider raising pool_size",
+               ESPHOME_SCHEDULER_POOL_SIZE);
+      this->pool_exhausted_logged_ = true;
+    }
+    item = new SchedulerItem();  // NOLINT(cppcoreguidelines-owning-memory)
+    item->pooled = false;
+  }
+  item->remove = false;
+  item->named = false;
+  item->name_hash = 0;
+  item->prev = nullptr;
+  item->next = nullptr;
+  item->index_next = nullptr;
+  return item;
+}
+void HOT Scheduler::release_(SchedulerItem *item) {
+  item->callback = nullptr;
+  item->state = SchedulerItem::FREE;
+  if (!item->pooled) {
+    delete item;  // NOLINT(cppcoreguidelines-owning-memory)
+    return;
+  }
+  item->next = this->free_;
+  this->free_ = item;
+}
+void HOT Scheduler::push_(SchedulerItem *item, const std::string &name) {
+  if (!name.empty()) {
+    item->named = true;
+    item->name_hash = fnv1_hash(name);
+    this->index_(item);
+  }
+  if (!this->started_) {
+    this->current_tick_ = this->millis_64_(this->last_millis_);
+    this->started_ = true;
+  }
+  this->insert_(item);
+#ifdef USE_LOOP_EVENT_DRIVEN
+  // The new item might be due before the main loop would wake up on its own
+  App.wake_loop();
+#endif
+}
+void HOT Scheduler::insert_(SchedulerItem *item) {
+  static const uint64_t WHEEL_RANGE = 1ULL << (WHEEL_LEVELS * WHEEL_BITS);
+
+  if (item->next_execution < this->current_tick_) {
+    // Its tick has already been processed, so the wheel would only run it a millisecond late. Queue it for the next
+    // call() instead, which is also where zero-delay timeouts ran with the heap based scheduler.
+    item->state = SchedulerItem::RUNNING;
+    item->next = nullptr;
+    if (this->immediate_tail_ != nullptr) {
+      this->immediate_tail_->next = item;
+    } else {
+      this->immediate_head_ = item;
+    }
+    this->immediate_tail_ = item;
+    return;
+  }
+
+  uint64_t expires = item->next_execution;
+  uint64_t delta = expires - this->current_tick_;
+  if (delta >= WHEEL_RANGE) {
+    // Too far away for the wheel, park it in the top level and re-insert it when that slot is cascaded
+    expires = this->current_tick_ + WHEEL_RANGE - 1;
+    delta = WHEEL_RANGE - 1;
+  }
+  uint8_t level = 0;
+  while (delta >= (1ULL << ((level + 1) * WHEEL_BITS)))
+    level++;
+  uint8_t slot = (expires >> (level * WHEEL_BITS)) & WHEEL_MASK;
+
+  item->state = SchedulerItem::SCHEDULED;
+  item->level = level;
+  item->slot = slot;
+  item->prev = nullptr;
+  item->next = this->slots_[level][slot];
+  if (item->next != nullptr)
+    item->next->prev = item;
+  this->slots_[level][slot] = item;
+  this->occupied_[level] |= 1UL << slot;
+}
+void HOT Scheduler::unlink_(SchedulerItem *item) {
+  if (item->prev != nullptr) {
+    item->prev->next = item->next;
+  } else {
+    this->slots_[item->level][item->slot] = item->next;
+    if (item->next == nullptr)
+      this->occupied_[item->level] &= ~(1UL << item->slot);
+  }
+  if (item->next != nullptr)
+    item->next->prev = item->prev;
+}
+void HOT Scheduler::cascade_(uint8_t level) {
+  if (level >= WHEEL_LEVELS)
+    return;
+  uint8_t slot = (this->current_tick_ >> (level * WHEEL_BITS)) & WHEEL_MASK;
+  SchedulerItem *item = this->slots_[level][slot];
+  this->slots_[level][slot] = nullptr;
+  this->occupied_[level] &= ~(1UL << slot);
+  while (item != nullptr) {
+    SchedulerItem *next = item->next;
+    this->insert_(item);
+    item = next;
+  }
+  if (slot == 0)
+    this->cascade_(level + 1);
+}
+void HOT Scheduler::advance_(uint64_t now) {
+  while (this->current_tick_ <= now) {
+    if (this->wheel_empty_()) {
+      this->current_tick_ = now + 1;
+      return;
+    }
+
+    uint8_t slot = this->current_tick_ & WHEEL_MASK;
+    if (slot == 0)
+      this->cascade_(1);
+
+    uint32_t pending = this->occupied_[0] >> slot;
+    if (pending == 0) {
+      // Nothing left in this rotation of the finest level, skip ahead to the next cascade
+      this->current_tick_ = std::min((this->current_tick_ | WHEEL_MASK) + 1, now + 1);
+      continue;
+    }
+    uint8_t skip = __builtin_ctz(pending);
+    if (this->current_tick_ + skip > now) {
+      this->current_tick_ = now + 1;
+      return;
+    }
+    this->current_tick_ += skip;
+    slot += skip;
+
+    // Move the whole slot to the end of the expired list
+    SchedulerItem *head = this->slots_[0][slot];
+    this->slots_[0][slot] = nullptr;
+    this->occupied_[0] &= ~(1UL << slot);
+    for (auto *item = head; item != nullptr; item = item->next)
+      item->state = SchedulerItem::RUNNING;
+    if (this->expired_tail_ != nullptr) {
+      this->expired_tail_->next = head;
+    } else {
+      this->expired_head_ = head;
+    }
+    auto *tail = head;
+    while (tail->next != nullptr)
+      tail = tail->next;
+    this->expired_tail_ = tail;
+
+    this->current_tick_++;
+  }
+}
+void HOT Scheduler::index_(SchedulerItem *item) {
+  auto &bucket = this->index_buckets_[(item->name_hash ^ reinterpret_cast<uintptr_t>(item->component)) % INDEX_BUCKETS];
+  item->index_next = bucket;
+  bucket = item;
+}
+void HOT Scheduler::unindex_(SchedulerItem *item) {
+  if (!item->named)
+    return;
+  auto **link = &this->index_buckets_[(item->name_hash ^ reinterpret_cast<uintptr_t>(item->component)) % INDEX_BUCKETS];
+  while (*link != nullptr) {
+    if (*link == item) {
+      *link = item->index_next;
+      break;
+    }
+    link = &(*link)->index_next;
+  }
+  item->named = false;
+}
+bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+  // Unnamed items are not indexed and can't be cancelled
+  if (name.empty())
+    return false;
+  const uint32_t name_hash = fnv1_hash(name);
+
+  // obtain lock because this function modifies the wheel and can be called from non-loop task context
+  LockGuard guard{this->lock_};
+  bool ret = false;
+  auto **link = &this->index_buckets_[(name_hash ^ reinterpret_cast<uintptr_t>(component)) % INDEX_BUCKETS];
+  while (*link != nullptr) {
+    SchedulerItem *item = *link;
+    if (item->component != component || item->name_hash != name_hash || item->type != type) {
+      link = &item->index_next;
+      continue;
+    }
+    *link = item->index_next;
+    item->named = false;
+    ret = true;
+    if (item->state == SchedulerItem::SCHEDULED) {
+      this->unlink_(item);
+      this->release_(item);
+    } else {
+      // Running or waiting in the expired or immediate list, it is released by call()
+      item->remove = true;
+    }
+  }
+  return ret;
+}
+#endif  // USE_SCHEDULER_TIMER_WHEEL
+
+uint32_t Scheduler::millis_() {
+  const uint32_t now = millis();
+  if (now < this->last_millis_) {
+    ESP_LOGD(TAG, "Incrementing scheduler major");
+    this->millis_major_++;
+  }
+  this->last_millis_ = now;
+  return now;
+}
+
 }  // namespace esphome
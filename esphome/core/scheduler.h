@@ -1,5 +1,6 @@
 #pragma once
 
+#include "esphome/core/defines.h"
 #include <vector>
 #include <memory>
 
@@ -12,6 +13,10 @@ class Component;
 
 class Scheduler {
  public:
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+  Scheduler();
+#endif
+
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func);
   bool cancel_timeout(Component *component, const std::string &name);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> func);
@@ -28,6 +33,7 @@ class Scheduler {
   void process_to_add();
 
  protected:
+#ifndef USE_SCHEDULER_TIMER_WHEEL
   struct SchedulerItem {
     Component *component;
     std::string name;
@@ -79,6 +85,85 @@ class Scheduler {
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
+#else
+  // Hierarchical timer wheel: WHEEL_LEVELS levels of WHEEL_SLOTS slots each, level N slots span 32^N ms.
+  // Deadlines further away than the top level are clamped and re-cascaded when their slot comes up.
+  static const uint8_t WHEEL_BITS = 5;
+  static const uint8_t WHEEL_SLOTS = 1 << WHEEL_BITS;
+  static const uint32_t WHEEL_MASK = WHEEL_SLOTS - 1;
+  static const uint8_t WHEEL_LEVELS = 4;
+  static const uint8_t INDEX_BUCKETS = 32;
+
+  struct SchedulerItem {
+    Component *component;
+    // Items are cancelled by fnv1_hash() of their name, the name string itself is not kept.
+    uint32_t name_hash;
+    enum Type : uint8_t { TIMEOUT, INTERVAL } type;
+    enum State : uint8_t { FREE, SCHEDULED, RUNNING } state;
+    bool named;
+    bool remove;
+    bool pooled;
+    uint8_t level;
+    uint8_t slot;
+    uint32_t interval;
+    uint64_t next_execution;
+    std::function<void()> callback;
+    // Links of the wheel slot, expired list or free list the item is currently part of
+    SchedulerItem *prev;
+    SchedulerItem *next;
+    // Link of the name hash bucket the item is part of (only when `named`)
+    SchedulerItem *index_next;
+
+    const char *get_type_str() {
+      switch (this->type) {
+        case SchedulerItem::INTERVAL:
+          return "interval";
+        case SchedulerItem::TIMEOUT:
+          return "timeout";
+        default:
+          return "";
+      }
+    }
+  };
+
+  uint32_t millis_();
+  uint64_t millis_64_(uint32_t now) { return (uint64_t(this->millis_major_) << 32) | now; }
+  SchedulerItem *acquire_();
+  void release_(SchedulerItem *item);
+  void push_(SchedulerItem *item, const std::string &name);
+  void insert_(SchedulerItem *item);
+  void unlink_(SchedulerItem *item);
+  void cascade_(uint8_t level);
+  void advance_(uint64_t now);
+  void index_(SchedulerItem *item);
+  void unindex_(SchedulerItem *item);
+  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  bool wheel_empty_() const {
+    for (uint32_t occupied : this->occupied_) {
+      if (occupied != 0)
+        return false;
+    }
+    return true;
+  }
+
+  Mutex lock_;
+  SchedulerItem pool_[ESPHOME_SCHEDULER_POOL_SIZE];
+  SchedulerItem *free_{nullptr};
+  SchedulerItem *slots_[WHEEL_LEVELS][WHEEL_SLOTS]{};
+  uint32_t occupied_[WHEEL_LEVELS]{};
+  SchedulerItem *index_buckets_[INDEX_BUCKETS]{};
+  SchedulerItem *expired_head_{nullptr};
+  SchedulerItem *expired_tail_{nullptr};
+  /// Items that were already due when they were added (like set_timeout(0) and defer()), run by the next call().
+  SchedulerItem *immediate_head_{nullptr};
+  SchedulerItem *immediate_tail_{nullptr};
+  /// The next tick (in 64-bit milliseconds) that has not been processed yet.
+  uint64_t current_tick_{0};
+  bool started_{false};
+  bool pool_exhausted_logged_{false};
+  uint32_t last_millis_{0};
+  uint8_t millis_major_{0};
+#endif  // USE_SCHEDULER_TIMER_WHEEL
 };
 
 }  // namespace esphome
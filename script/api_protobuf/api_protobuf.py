@@ -17,19 +17,40 @@ then run this script with python3 and the files
 will be generated, they still need to be formatted
 """
 
+import importlib.util
 import os
 import re
 import sys
 from abc import ABC, abstractmethod
 from pathlib import Path
 from subprocess import call
+from tempfile import TemporaryDirectory
 from textwrap import dedent
 
-# Generate with
-# protoc --python_out=script/api_protobuf -I esphome/components/api/ api_options.proto
-import aioesphomeapi.api_options_pb2 as pb
 import google.protobuf.descriptor_pb2 as descriptor
 
+
+def load_api_options():
+    """Compile api_options.proto from this tree and import it.
+
+    The options in the released aioesphomeapi package lag behind the ones defined here,
+    so they are always generated from the local file instead.
+    """
+    api_dir = Path(__file__).resolve().parent.parent.parent / "esphome/components/api"
+    with TemporaryDirectory() as tmp:
+        call(
+            ["protoc", f"--python_out={tmp}", "-I", str(api_dir), "api_options.proto"]
+        )
+        spec = importlib.util.spec_from_file_location(
+            "api_options_pb2", Path(tmp) / "api_options_pb2.py"
+        )
+        module = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(module)
+    return module
+
+
+pb = load_api_options()
+
 FILE_HEADER = """// This file was automatically generated with a tool.
 // See scripts/api_protobuf/api_protobuf.py
 """
@@ -176,6 +197,14 @@ class TypeInfo(ABC):
 
     encode_func = None
 
+    @property
+    def size_func(self):
+        return self.encode_func.replace("encode_", "add_", 1)
+
+    @property
+    def calculate_size_content(self):
+        return f"ProtoSize::{self.size_func}(total_size, {self.number}, this->{self.field_name});"
+
     @property
     def dump_content(self):
         o = f'out.append("  {self.name}: ");\n'
@@ -316,6 +345,21 @@ class StringType(TypeInfo):
         return o
 
 
+class StringRefType(TypeInfo):
+    """string/bytes field with the zero_copy option, pointing into the received packet."""
+
+    cpp_type = "StringRef"
+    default_value = ""
+    reference_type = "StringRef &"
+    const_reference_type = "const StringRef &"
+    decode_length = "value.as_string_ref()"
+    encode_func = "encode_string"
+
+    def dump(self, name):
+        o = f'out.append("\'").append({name}.c_str(), {name}.size()).append("\'");'
+        return o
+
+
 @register_type(11)
 class MessageType(TypeInfo):
     @property
@@ -445,10 +489,16 @@ class SInt64Type(TypeInfo):
         return o
 
 
+def create_type_info(field):
+    if field.type in (9, 12) and get_opt(field, pb.zero_copy, False):
+        return StringRefType(field)
+    return TYPE_INFO[field.type](field)
+
+
 class RepeatedTypeInfo(TypeInfo):
     def __init__(self, field):
         super().__init__(field)
-        self._ti = TYPE_INFO[field.type](field)
+        self._ti = create_type_info(field)
 
     @property
     def cpp_type(self):
@@ -526,6 +576,13 @@ class RepeatedTypeInfo(TypeInfo):
         o += "}"
         return o
 
+    @property
+    def calculate_size_content(self):
+        o = f"for (auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{\n"
+        o += f"  ProtoSize::{self._ti.size_func}(total_size, {self.number}, it, true);\n"
+        o += "}"
+        return o
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -569,16 +626,18 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    calculate_size = []
     dump = []
 
     for field in desc.field:
         if field.label == 3:
             ti = RepeatedTypeInfo(field)
         else:
-            ti = TYPE_INFO[field.type](field)
+            ti = create_type_info(field)
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        calculate_size.append(ti.calculate_size_content)
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -645,6 +704,18 @@ def build_message_type(desc):
     prot = "void encode(ProtoWriteBuffer buffer) const override;"
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{"
+    if calculate_size:
+        if len(calculate_size) == 1 and len(calculate_size[0]) + len(o) + 3 < 120:
+            o += f" {calculate_size[0]} "
+        else:
+            o += "\n"
+            o += indent("\n".join(calculate_size)) + "\n"
+    o += "}\n"
+    cpp += o
+    prot = "void calculate_size(uint32_t &total_size) const override;"
+    public_content.append(prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{"
     if dump:
         if len(dump) == 1 and len(dump[0]) + len(o) + 3 < 120: